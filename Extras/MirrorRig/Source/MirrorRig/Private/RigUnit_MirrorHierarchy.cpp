@@ -0,0 +1,175 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RigUnit_MirrorHierarchy.h"
+#include "Units/RigUnitContext.h"
+#include "Animation/AnimTypes.h"
+
+namespace
+{
+    bool IsMirroredControlType(ERigControlType ControlType)
+    {
+        return ControlType == ERigControlType::Transform
+            || ControlType == ERigControlType::TransformNoScale
+            || ControlType == ERigControlType::EulerTransform;
+    }
+
+    void BuildElementData(ERigElementType ElementType, const TArray<FName>& Names, const TArray<FTransform>& InitialGlobals, const TArray<FTransform>& InitialLocals,
+        const TArray<FName>& AllCurves, FMirrorTableBuilder& Builder, FMirrorTable& OutTable, const FRigHierarchyContainer* Hierarchy, FRigUnit_MirrorHierarchy_ElementData& OutData)
+    {
+        OutData.Reset();
+        Builder.Build(Names, InitialGlobals, AllCurves, OutTable);
+
+        // Center elements pair with themselves and take a single slot
+        for(const FMirrorBonePair& Pair : OutTable.BonePairs){
+            int32 ASlot = OutData.Keys.Add(FRigElementKey(Pair.ABone, ElementType));
+            int32 BSlot = ASlot;
+            if(Pair.BBoneIndex != Pair.ABoneIndex)
+                BSlot = OutData.Keys.Add(FRigElementKey(Pair.BBone, ElementType));
+
+            OutData.Batch.AddPair(Pair, ASlot, BSlot, InitialLocals[Pair.ABoneIndex], InitialLocals[Pair.BBoneIndex]);
+        }
+
+        OutData.CachedElements.SetNum(OutData.Keys.Num());
+        OutData.Transforms.SetNum(OutData.Keys.Num());
+        OutData.UpdateCache(Hierarchy);
+    }
+
+    template<typename GetFuncType, typename SetFuncType>
+    void MirrorElements(FRigUnit_MirrorHierarchy_ElementData& Data, float Weight, GetFuncType&& GetLocalTransform, SetFuncType&& SetLocalTransform)
+    {
+        if(Data.Keys.Num() == 0)
+            return;
+
+        for(int32 i = 0; i < Data.Keys.Num(); i++)
+            Data.Transforms[i] = GetLocalTransform(Data.CachedElements[i].GetIndex());
+
+        Data.Batch.Execute(Data.Transforms, Weight);
+
+        for(int32 i = 0; i < Data.Keys.Num(); i++)
+            SetLocalTransform(Data.CachedElements[i].GetIndex(), Data.Transforms[i]);
+    }
+}
+
+void FRigUnit_MirrorHierarchy_ElementData::Reset()
+{
+    Keys.Reset();
+    CachedElements.Reset();
+    Batch.Reset();
+    Transforms.Reset();
+}
+
+bool FRigUnit_MirrorHierarchy_ElementData::UpdateCache(const FRigHierarchyContainer* Hierarchy)
+{
+    for(int32 i = 0; i < Keys.Num(); i++){
+        if(!CachedElements[i].UpdateCache(Keys[i], Hierarchy))
+            return false;
+    }
+    return true;
+}
+
+void FRigUnit_MirrorHierarchy_WorkData::Reset()
+{
+    bInitialized = false;
+    Bones.Reset();
+    Controls.Reset();
+    CurveKeys.Reset();
+    CachedCurves.Reset();
+}
+
+FRigUnit_MirrorHierarchy_Execute()
+{
+    DECLARE_SCOPE_HIERARCHICAL_COUNTER_RIGUNIT()
+
+    FRigHierarchyContainer* Hierarchy = ExecuteContext.Hierarchy;
+    if(Hierarchy == nullptr)
+        return;
+
+    if(Context.State == EControlRigState::Init){
+        WorkData.Reset();
+        return;
+    }
+
+    // Cached indices only go stale when the hierarchy changes underneath the rig
+    if(WorkData.bInitialized){
+        bool bCacheValid = WorkData.Bones.UpdateCache(Hierarchy) && WorkData.Controls.UpdateCache(Hierarchy);
+        for(int32 i = 0; bCacheValid && i < WorkData.CurveKeys.Num(); i++)
+            bCacheValid = WorkData.CachedCurves[i].UpdateCache(WorkData.CurveKeys[i], Hierarchy);
+
+        if(!bCacheValid)
+            WorkData.Reset();
+    }
+
+    FRigBoneHierarchy& BoneHierarchy = Hierarchy->BoneHierarchy;
+    FRigControlHierarchy& ControlHierarchy = Hierarchy->ControlHierarchy;
+    FRigCurveContainer& CurveContainer = Hierarchy->CurveContainer;
+
+    if(!WorkData.bInitialized){
+        FMirrorTableBuilder Builder(MirPlane, SearchReplaceKeyPair, SkipCheckKeyStr);
+        FMirrorTable Table;
+
+        TArray<FName> AllCurves;
+        if(bMirrorCurves){
+            for(int32 i = 0; i < CurveContainer.Num(); i++)
+                AllCurves.Add(CurveContainer[i].Name);
+        }
+
+        TArray<FName> Names;
+        TArray<FTransform> InitialGlobals, InitialLocals;
+        for(int32 i = 0; i < BoneHierarchy.Num(); i++){
+            Names.Add(BoneHierarchy[i].Name);
+            InitialGlobals.Add(BoneHierarchy.GetInitialGlobalTransform(i));
+            InitialLocals.Add(BoneHierarchy.GetInitialLocalTransform(i));
+        }
+        BuildElementData(ERigElementType::Bone, Names, InitialGlobals, InitialLocals, AllCurves, Builder, Table, Hierarchy, WorkData.Bones);
+
+        for(const FMirrorCurvePair& Pair : Table.CurvePairs){
+            WorkData.CurveKeys.Add(FRigElementKey(Pair.ACurve, ERigElementType::Curve));
+            WorkData.CurveKeys.Add(FRigElementKey(Pair.BCurve, ERigElementType::Curve));
+        }
+        WorkData.CachedCurves.SetNum(WorkData.CurveKeys.Num());
+        for(int32 i = 0; i < WorkData.CurveKeys.Num(); i++)
+            WorkData.CachedCurves[i].UpdateCache(WorkData.CurveKeys[i], Hierarchy);
+
+        if(bMirrorControls){
+            Names.Reset();
+            InitialGlobals.Reset();
+            InitialLocals.Reset();
+            for(int32 i = 0; i < ControlHierarchy.Num(); i++){
+                const FRigControl& Control = ControlHierarchy[i];
+                if(!IsMirroredControlType(Control.ControlType))
+                    continue;
+
+                Names.Add(Control.Name);
+                InitialGlobals.Add(Hierarchy->GetInitialGlobalTransform(Control.GetElementKey()));
+                InitialLocals.Add(ControlHierarchy.GetLocalTransform(i, ERigControlValueType::Initial));
+            }
+            BuildElementData(ERigElementType::Control, Names, InitialGlobals, InitialLocals, TArray<FName>(), Builder, Table, Hierarchy, WorkData.Controls);
+        }
+
+        WorkData.bInitialized = true;
+    }
+
+    if(Weight <= ZERO_ANIMWEIGHT_THRESH)
+        return;
+
+    // Locals are written without propagation, globals are recomputed once afterwards
+    MirrorElements(WorkData.Bones, Weight,
+        [&BoneHierarchy](int32 Index){ return BoneHierarchy.GetLocalTransform(Index); },
+        [&BoneHierarchy](int32 Index, const FTransform& Transform){ BoneHierarchy.SetLocalTransform(Index, Transform, false); });
+    if(WorkData.Bones.Keys.Num() > 0)
+        BoneHierarchy.RecomputeGlobalTransforms();
+
+    MirrorElements(WorkData.Controls, Weight,
+        [&ControlHierarchy](int32 Index){ return ControlHierarchy.GetLocalTransform(Index); },
+        [&ControlHierarchy](int32 Index, const FTransform& Transform){ ControlHierarchy.SetLocalTransform(Index, Transform); });
+
+    for(int32 i = 0; i < WorkData.CachedCurves.Num(); i += 2){
+        int32 AIndex = WorkData.CachedCurves[i].GetIndex();
+        int32 BIndex = WorkData.CachedCurves[i + 1].GetIndex();
+        float AVal = CurveContainer.GetValue(AIndex);
+        float BVal = CurveContainer.GetValue(BIndex);
+        CurveContainer.SetValue(AIndex, FMath::Lerp(AVal, BVal, Weight));
+        CurveContainer.SetValue(BIndex, FMath::Lerp(BVal, AVal, Weight));
+    }
+}
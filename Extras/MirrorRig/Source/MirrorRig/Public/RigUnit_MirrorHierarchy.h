@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Units/Highlevel/RigUnit_HighlevelBase.h"
+#include "MirrorTable.h"
+#include "MirrorBoneKernels.h"
+#include "RigUnit_MirrorHierarchy.generated.h"
+
+/** Elements of one hierarchy resolved against a mirror table, cached across executions */
+USTRUCT()
+struct MIRRORRIG_API FRigUnit_MirrorHierarchy_ElementData
+{
+	GENERATED_BODY()
+
+	/** One entry per slot of the kernel batch */
+	UPROPERTY()
+	TArray<FRigElementKey> Keys;
+
+	UPROPERTY()
+	TArray<FCachedRigElement> CachedElements;
+
+	FMirrorBoneKernelBatch Batch;
+
+	TArray<FTransform> Transforms;
+
+	void Reset();
+	bool UpdateCache(const FRigHierarchyContainer* Hierarchy);
+};
+
+USTRUCT()
+struct MIRRORRIG_API FRigUnit_MirrorHierarchy_WorkData
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	bool bInitialized = false;
+
+	UPROPERTY()
+	FRigUnit_MirrorHierarchy_ElementData Bones;
+
+	UPROPERTY()
+	FRigUnit_MirrorHierarchy_ElementData Controls;
+
+	/** Two entries per curve pair */
+	UPROPERTY()
+	TArray<FRigElementKey> CurveKeys;
+
+	UPROPERTY()
+	TArray<FCachedRigElement> CachedCurves;
+
+	void Reset();
+};
+
+/**
+ * Mirrors the bones, and optionally the transform controls and curves, of the hierarchy
+ * with the same pairing and flipping rules as the Anim Mirror node. Pairs are built from
+ * the initial pose once and the element indices are cached across executions.
+ */
+USTRUCT(meta=(DisplayName="Mirror Hierarchy", Category="Hierarchy", Keywords="Mirror,Flip,Symmetry"))
+struct MIRRORRIG_API FRigUnit_MirrorHierarchy : public FRigUnit_HighlevelBaseMutable
+{
+	GENERATED_BODY()
+
+	FRigUnit_MirrorHierarchy()
+		: MirPlane(MirrorPlane::YZ_Plane)
+		, SearchReplaceKeyPair(TEXT("_l,_r,_lt,_rt,_left,_right,L_,R_,_L_,_R_,Left,Right"))
+		, SkipCheckKeyStr(TEXT(""))
+		, bMirrorControls(false)
+		, bMirrorCurves(false)
+		, Weight(1.f)
+	{}
+
+	RIGVM_METHOD()
+	virtual void Execute(const FRigUnitContext& Context) override;
+
+	UPROPERTY(meta = (Input, Constant))
+	MirrorPlane MirPlane;
+
+	UPROPERTY(meta = (Input, Constant))
+	FString SearchReplaceKeyPair;
+
+	UPROPERTY(meta = (Input, Constant))
+	FString SkipCheckKeyStr;
+
+	UPROPERTY(meta = (Input, Constant))
+	bool bMirrorControls;
+
+	UPROPERTY(meta = (Input, Constant))
+	bool bMirrorCurves;
+
+	/** Blend between the current and the mirrored pose */
+	UPROPERTY(meta = (Input, ClampMin = "0.0", ClampMax = "1.0"))
+	float Weight;
+
+	UPROPERTY(transient)
+	FRigUnit_MirrorHierarchy_WorkData WorkData;
+};
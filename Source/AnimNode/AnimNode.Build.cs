@@ -43,6 +43,11 @@ public class AnimNode : ModuleRules
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
+
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("DerivedDataCache");
+		}
 		
 		
 		DynamicallyLoadedModuleNames.AddRange(
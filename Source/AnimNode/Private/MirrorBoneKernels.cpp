@@ -0,0 +1,246 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MirrorBoneKernels.h"
+#include "Templates/IntegerSequence.h"
+#include "Animation/AnimTypes.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    /** Destination axis of source axis Axis, permutations ordered 012, 021, 102, 120, 201, 210 */
+    constexpr int32 GetKernelAxis(uint32 PermIndex, int32 Axis)
+    {
+        return Axis == 0 ? (int32)(PermIndex / 2)
+            : ((Axis == 1) == (PermIndex % 2 == 0)) ? (PermIndex / 2 == 0 ? 1 : 0)
+            : (PermIndex / 2 == 2 ? 1 : 2);
+    }
+
+    constexpr bool IsOddKernelPermutation(uint32 PermIndex)
+    {
+        return PermIndex == 1 || PermIndex == 2 || PermIndex == 5;
+    }
+
+    /** Translation sign of source axis Axis */
+    constexpr int32 GetKernelTranslateSign(uint32 SignBits, int32 Axis)
+    {
+        return ((SignBits >> Axis) & 1) ? -1 : 1;
+    }
+
+    /**
+     * Rotation sign of source axis Axis. Rotations flip like axial vectors, so each one is the
+     * translation sign times the determinant of the signed permutation.
+     */
+    constexpr int32 GetKernelRotateSign(uint32 PermIndex, uint32 SignBits, int32 Axis)
+    {
+        return GetKernelTranslateSign(SignBits, Axis) * (IsOddKernelPermutation(PermIndex) ? -1 : 1)
+            * GetKernelTranslateSign(SignBits, 0) * GetKernelTranslateSign(SignBits, 1) * GetKernelTranslateSign(SignBits, 2);
+    }
+
+    template<uint32 Pattern>
+    FORCEINLINE FTransform MirrorBoneDelta(const FTransform& Delta)
+    {
+        constexpr uint32 PermIndex = Pattern / 8;
+        constexpr uint32 SignBits = Pattern % 8;
+        constexpr int32 X = GetKernelAxis(PermIndex, 0);
+        constexpr int32 Y = GetKernelAxis(PermIndex, 1);
+        constexpr int32 Z = GetKernelAxis(PermIndex, 2);
+
+        const FVector Loc = Delta.GetTranslation();
+        const FRotator Rot = Delta.Rotator();
+
+        float NLoc[3];
+        NLoc[X] = Loc.X * GetKernelTranslateSign(SignBits, 0);
+        NLoc[Y] = Loc.Y * GetKernelTranslateSign(SignBits, 1);
+        NLoc[Z] = Loc.Z * GetKernelTranslateSign(SignBits, 2);
+
+        float NRot[3];
+        NRot[X] = Rot.Roll * GetKernelRotateSign(PermIndex, SignBits, 0);
+        NRot[Y] = Rot.Pitch * GetKernelRotateSign(PermIndex, SignBits, 1);
+        NRot[Z] = Rot.Yaw * GetKernelRotateSign(PermIndex, SignBits, 2);
+
+        return FTransform(FRotator(NRot[1], NRot[2], NRot[0]), FVector(NLoc[0], NLoc[1], NLoc[2]));
+    }
+
+    FORCEINLINE FTransform MirrorBoneDeltaGeneric(const FTransform& Delta, const FMirrorFlippingRuleData& Rule)
+    {
+        float Temp[3] = {0, 0, 0};
+
+        const FVector Loc = Delta.GetTranslation();
+        const FRotator Rot = Delta.Rotator();
+
+        Temp[Rule.FlipAttrInfo[0]] = Loc.X * Rule.FlipValInfo[0];
+        Temp[Rule.FlipAttrInfo[1]] = Loc.Y * Rule.FlipValInfo[1];
+        Temp[Rule.FlipAttrInfo[2]] = Loc.Z * Rule.FlipValInfo[2];
+
+        FVector NLoc(Temp[0], Temp[1], Temp[2]);
+
+        Temp[Rule.FlipAttrInfo[3] - 3] = Rot.Roll * Rule.FlipValInfo[3];
+        Temp[Rule.FlipAttrInfo[4] - 3] = Rot.Pitch * Rule.FlipValInfo[4];
+        Temp[Rule.FlipAttrInfo[5] - 3] = Rot.Yaw * Rule.FlipValInfo[5];
+
+        return FTransform(FRotator(Temp[1], Temp[2], Temp[0]), NLoc);
+    }
+
+    typedef void (*FMirrorBoneGroupFunc)(const FMirrorBoneKernelPair* Pairs, int32 Num, const FMirrorBoneKernelBatch& Batch, FTransform* Bones, float Weight);
+
+    template<bool bBlend>
+    FORCEINLINE void WriteMirroredPair(const FMirrorBoneKernelPair& Pair, const FTransform& A, const FTransform& B, const FTransform& NA, const FTransform& NB, FTransform* Bones, float Weight)
+    {
+        if(bBlend){
+            Bones[Pair.AIndex].Blend(A, NA, Weight);
+            Bones[Pair.BIndex].Blend(B, NB, Weight);
+        }
+        else{
+            Bones[Pair.AIndex] = NA;
+            Bones[Pair.BIndex] = NB;
+        }
+    }
+
+    // Both sides are read before either is written. Center bones pair with themselves
+    // and simply get the same result written twice.
+    template<uint32 Pattern, bool bBlend>
+    void MirrorBoneGroup(const FMirrorBoneKernelPair* Pairs, int32 Num, const FMirrorBoneKernelBatch& Batch, FTransform* Bones, float Weight)
+    {
+        for(int32 i = 0; i < Num; i++){
+            const FMirrorBoneKernelPair& Pair = Pairs[i];
+            const FTransform A = Bones[Pair.AIndex];
+            const FTransform B = Bones[Pair.BIndex];
+            const FTransform NA = MirrorBoneDelta<Pattern>(B.GetRelativeTransform(Pair.BRefPose)) * Pair.ARefPose;
+            const FTransform NB = MirrorBoneDelta<Pattern>(A.GetRelativeTransform(Pair.ARefPose)) * Pair.BRefPose;
+            WriteMirroredPair<bBlend>(Pair, A, B, NA, NB, Bones, Weight);
+        }
+    }
+
+    template<bool bBlend>
+    void MirrorBoneGroupGeneric(const FMirrorBoneKernelPair* Pairs, int32 Num, const FMirrorBoneKernelBatch& Batch, FTransform* Bones, float Weight)
+    {
+        for(int32 i = 0; i < Num; i++){
+            const FMirrorBoneKernelPair& Pair = Pairs[i];
+            const FMirrorFlippingRuleData& Rule = Batch.GenericRules[Pair.GenericRuleIndex];
+            const FTransform A = Bones[Pair.AIndex];
+            const FTransform B = Bones[Pair.BIndex];
+            const FTransform NA = MirrorBoneDeltaGeneric(B.GetRelativeTransform(Pair.BRefPose), Rule) * Pair.ARefPose;
+            const FTransform NB = MirrorBoneDeltaGeneric(A.GetRelativeTransform(Pair.ARefPose), Rule) * Pair.BRefPose;
+            WriteMirroredPair<bBlend>(Pair, A, B, NA, NB, Bones, Weight);
+        }
+    }
+
+    template<bool bBlend, uint32... Patterns>
+    const FMirrorBoneGroupFunc* GetMirrorBoneGroupFuncs(TIntegerSequence<uint32, Patterns...>)
+    {
+        static const FMirrorBoneGroupFunc Funcs[] = { &MirrorBoneGroup<Patterns, bBlend>..., &MirrorBoneGroupGeneric<bBlend> };
+        return Funcs;
+    }
+
+    template<bool bBlend>
+    const FMirrorBoneGroupFunc* GetMirrorBoneGroupFuncs()
+    {
+        return GetMirrorBoneGroupFuncs<bBlend>(TMakeIntegerSequence<uint32, MIRROR_KERNEL_PATTERN_NUM>());
+    }
+}
+
+void FMirrorBoneKernelBatch::Reset()
+{
+    Pairs.Reset();
+    Groups.Reset();
+    GenericRules.Reset();
+    UsedIndices.Reset();
+    bPairsDisjoint = true;
+}
+
+void FMirrorBoneKernelBatch::AddPair(const FMirrorBonePair& TablePair, int32 AIndex, int32 BIndex, const FTransform& ARefPose, const FTransform& BRefPose)
+{
+    if(Groups.Num() == 0 || Groups.Last().Pattern != TablePair.KernelPattern){
+        checkSlow(Groups.Num() == 0 || Groups.Last().Pattern < TablePair.KernelPattern);
+        FMirrorBoneKernelGroup& Group = Groups.AddDefaulted_GetRef();
+        Group.Pattern = TablePair.KernelPattern;
+        Group.StartIndex = Pairs.Num();
+        Group.Num = 0;
+    }
+    Groups.Last().Num++;
+
+    // Center bones pair with themselves, only sharing across pairs is a race
+    int32 MaxIndex = FMath::Max(AIndex, BIndex);
+    if(UsedIndices.Num() <= MaxIndex)
+        UsedIndices.Add(false, MaxIndex + 1 - UsedIndices.Num());
+    if(UsedIndices[AIndex] || UsedIndices[BIndex])
+        bPairsDisjoint = false;
+    UsedIndices[AIndex] = true;
+    UsedIndices[BIndex] = true;
+
+    FMirrorBoneKernelPair& Pair = Pairs.AddDefaulted_GetRef();
+    Pair.AIndex = AIndex;
+    Pair.BIndex = BIndex;
+    Pair.GenericRuleIndex = INDEX_NONE;
+    Pair.ARefPose = ARefPose;
+    Pair.BRefPose = BRefPose;
+    if(TablePair.KernelPattern == MIRROR_KERNEL_PATTERN_GENERIC)
+        Pair.GenericRuleIndex = GenericRules.Add(TablePair.FlippingRule);
+}
+
+void FMirrorBoneKernelBatch::Execute(TArrayView<FTransform> Bones, float Weight) const
+{
+    ExecuteRange(Bones, Weight, 0, Pairs.Num());
+}
+
+void FMirrorBoneKernelBatch::ExecuteRange(TArrayView<FTransform> Bones, float Weight, int32 StartPair, int32 EndPair) const
+{
+    static const FMirrorBoneGroupFunc* MirrorFuncs = GetMirrorBoneGroupFuncs<false>();
+    static const FMirrorBoneGroupFunc* BlendFuncs = GetMirrorBoneGroupFuncs<true>();
+
+    const FMirrorBoneGroupFunc* GroupFuncs = Weight < 1.f - ZERO_ANIMWEIGHT_THRESH ? BlendFuncs : MirrorFuncs;
+    for(const FMirrorBoneKernelGroup& Group : Groups){
+        int32 Start = FMath::Max(Group.StartIndex, StartPair);
+        int32 End = FMath::Min(Group.StartIndex + Group.Num, EndPair);
+        if(Start < End)
+            GroupFuncs[Group.Pattern](Pairs.GetData() + Start, End - Start, *this, Bones.GetData(), Weight);
+    }
+}
+
+void FMirrorBoneKernelBatch::ExecuteParallel(TArrayView<FTransform> Bones, float Weight, int32 MinChunkPairs) const
+{
+    // Smallest pair count that fills whole cache lines
+    const int32 LinePairs = PLATFORM_CACHE_LINE_SIZE / FMath::GreatestCommonDivisor((int32)sizeof(FMirrorBoneKernelPair), PLATFORM_CACHE_LINE_SIZE);
+    const int32 ChunkPairs = FMath::DivideAndRoundUp(FMath::Max(MinChunkPairs, 1), LinePairs) * LinePairs;
+    const int32 NumChunks = FMath::DivideAndRoundUp(Pairs.Num(), ChunkPairs);
+    if(NumChunks <= 1 || !bPairsDisjoint){
+        Execute(Bones, Weight);
+        return;
+    }
+
+    ParallelFor(NumChunks, [this, Bones, Weight, ChunkPairs](int32 ChunkIndex){
+        int32 StartPair = ChunkIndex * ChunkPairs;
+        ExecuteRange(Bones, Weight, StartPair, FMath::Min(StartPair + ChunkPairs, Pairs.Num()));
+    });
+}
+
+uint16 FMirrorBoneKernelBatch::GetKernelPattern(const FMirrorFlippingRuleData& Rule)
+{
+    if(Rule.FlipAttrInfo.Num() != 6 || Rule.FlipValInfo.Num() != 6)
+        return MIRROR_KERNEL_PATTERN_GENERIC;
+
+    uint32 SignBits = 0;
+    for(int32 j = 0; j < 3; j++){
+        int Val = Rule.FlipValInfo[j];
+        if(Val != 1 && Val != -1)
+            return MIRROR_KERNEL_PATTERN_GENERIC;
+        if(Val < 0)
+            SignBits |= 1 << j;
+    }
+
+    for(uint32 PermIndex = 0; PermIndex < 6; PermIndex++){
+        bool bMatch = true;
+        for(int32 j = 0; j < 3; j++){
+            int32 Axis = GetKernelAxis(PermIndex, j);
+            if(Rule.FlipAttrInfo[j] != Axis || Rule.FlipAttrInfo[j + 3] != Axis + 3)
+                bMatch = false;
+            // Rotation signs are implied by the kernel, any rule that disagrees stays generic
+            if(Rule.FlipValInfo[j + 3] != GetKernelRotateSign(PermIndex, SignBits, j))
+                bMatch = false;
+        }
+        if(bMatch)
+            return (uint16)(PermIndex * 8 + SignBits);
+    }
+    return MIRROR_KERNEL_PATTERN_GENERIC;
+}
@@ -0,0 +1,151 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MirrorMorphTargetUserData.h"
+#include "Animation/MorphTarget.h"
+#include "Engine/SkeletalMesh.h"
+#include "Containers/Ticker.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMirrorMorphTarget, Log, All);
+
+void UMirrorMorphTargetUserData::GetPreloadDependencies(TArray<UObject*>& OutDeps)
+{
+    Super::GetPreloadDependencies(OutDeps);
+
+    // Cooked packages serialize both sides before this object, so Serialize can rebuild right away
+    for(const FMirrorMorphTargetPair& Pair : Pairs){
+        if(Pair.SourceMorphTarget)
+            OutDeps.Add(Pair.SourceMorphTarget);
+        if(Pair.MirroredMorphTarget)
+            OutDeps.Add(Pair.MirroredMorphTarget);
+    }
+}
+
+bool UMirrorMorphTargetUserData::AreMorphTargetsSerialized() const
+{
+    for(const FMirrorMorphTargetPair& Pair : Pairs){
+        if(Pair.SourceMorphTarget && Pair.SourceMorphTarget->HasAnyFlags(RF_NeedLoad))
+            return false;
+        if(Pair.MirroredMorphTarget && Pair.MirroredMorphTarget->HasAnyFlags(RF_NeedLoad))
+            return false;
+    }
+    return true;
+}
+
+void UMirrorMorphTargetUserData::Serialize(FArchive& Ar)
+{
+    Super::Serialize(Ar);
+
+    // Nothing is forced to load here. Rebuilding during serialization puts the deltas in place
+    // before any PostLoad of the package, the mesh one that builds render resources included.
+    bRebuiltOnLoad = false;
+    if(Ar.IsLoading() && !Ar.IsTransacting() && AreMorphTargetsSerialized()){
+        RebuildMirroredMorphTargets();
+        bRebuiltOnLoad = true;
+    }
+}
+
+void UMirrorMorphTargetUserData::PostLoad()
+{
+    Super::PostLoad();
+
+    // Loaders without preload dependencies serialize every export of the package first
+    if(bRebuiltOnLoad)
+        return;
+
+    for(FMirrorMorphTargetPair& Pair : Pairs){
+        if(Pair.SourceMorphTarget)
+            Pair.SourceMorphTarget->ConditionalPostLoad();
+    }
+    RebuildMirroredMorphTargets();
+    bRebuiltOnLoad = true;
+
+    USkeletalMesh* Mesh = GetTypedOuter<USkeletalMesh>();
+    if(Mesh && !Mesh->HasAnyFlags(RF_NeedPostLoad))
+        UE_LOG(LogMirrorMorphTarget, Warning, TEXT("%s was post loaded before its mirrored morph targets were rebuilt, they stay flat until the mesh is rebuilt"), *Mesh->GetPathName());
+}
+
+void UMirrorMorphTargetUserData::PreSave(const class ITargetPlatform* TargetPlatform)
+{
+    Super::PreSave(TargetPlatform);
+
+    // Runs before any export of the package is written. The live deltas come back on the
+    // next core tick, which also covers saves that fail and never broadcast PackageSavedEvent.
+    StripMirroredMorphTargets();
+    if(!bRestorePending){
+        bRestorePending = true;
+        TWeakObjectPtr<UMirrorMorphTargetUserData> WeakThis(this);
+        FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis](float){
+            if(UMirrorMorphTargetUserData* This = WeakThis.Get()){
+                This->bRestorePending = false;
+                This->RebuildMirroredMorphTargets();
+            }
+            return false;
+        }));
+    }
+}
+
+void UMirrorMorphTargetUserData::RebuildMirroredMorphTargets()
+{
+    for(FMirrorMorphTargetPair& Pair : Pairs){
+        if(Pair.SourceMorphTarget == nullptr || Pair.MirroredMorphTarget == nullptr)
+            continue;
+
+        TArray<FMorphTargetLODModel>& LODModels = Pair.MirroredMorphTarget->MorphLODModels;
+        MirrorMorphTargetDeltas(Pair.SourceMorphTarget, LODSymmetryMaps, MirPlane, LODModels);
+        for(int32 LODIndex = 0; LODIndex < LODModels.Num() && LODIndex < Pair.LODSectionIndices.Num(); LODIndex++)
+            LODModels[LODIndex].SectionIndices = Pair.LODSectionIndices[LODIndex].SectionIndices;
+    }
+}
+
+void UMirrorMorphTargetUserData::StripMirroredMorphTargets()
+{
+    for(FMirrorMorphTargetPair& Pair : Pairs){
+        if(Pair.MirroredMorphTarget == nullptr)
+            continue;
+
+        for(FMorphTargetLODModel& LODModel : Pair.MirroredMorphTarget->MorphLODModels)
+            LODModel.Vertices.Empty();
+    }
+}
+
+void UMirrorMorphTargetUserData::MirrorMorphTargetDeltas(const UMorphTarget* Source, const TArray<FMirrorVertexSymmetryMap>& SymmetryMaps, MirrorPlane InMirPlane, TArray<FMorphTargetLODModel>& OutLODModels)
+{
+    int32 MirrorAxis = FMirrorTableBuilder::GetMirrorAxis(InMirPlane);
+
+    const TArray<FMorphTargetLODModel>& SourceLODModels = Source->MorphLODModels;
+    OutLODModels.SetNum(SourceLODModels.Num());
+
+    TArray<int32> SourceDeltaIds;
+    for(int32 LODIndex = 0; LODIndex < SourceLODModels.Num(); LODIndex++){
+        const FMorphTargetLODModel& SourceLOD = SourceLODModels[LODIndex];
+        FMorphTargetLODModel& OutLOD = OutLODModels[LODIndex];
+        OutLOD.Vertices.Reset();
+        OutLOD.NumBaseMeshVerts = SourceLOD.NumBaseMeshVerts;
+        OutLOD.SectionIndices.Reset();
+        OutLOD.bGeneratedByEngine = SourceLOD.bGeneratedByEngine;
+        if(!SymmetryMaps.IsValidIndex(LODIndex))
+            continue;
+
+        const TArray<int32>& MirrorIndices = SymmetryMaps[LODIndex].MirrorVertexIndices;
+        SourceDeltaIds.Init(INDEX_NONE, MirrorIndices.Num());
+        for(int32 i = 0; i < SourceLOD.Vertices.Num(); i++){
+            if(SourceDeltaIds.IsValidIndex(SourceLOD.Vertices[i].SourceIdx))
+                SourceDeltaIds[SourceLOD.Vertices[i].SourceIdx] = i;
+        }
+
+        // Walk the mirrored side, so every vertex duplicated along a uv seam gets its delta
+        OutLOD.Vertices.Reserve(SourceLOD.Vertices.Num());
+        for(int32 VertIndex = 0; VertIndex < MirrorIndices.Num(); VertIndex++){
+            int32 MirrorIndex = MirrorIndices[VertIndex];
+            if(MirrorIndex == INDEX_NONE || SourceDeltaIds[MirrorIndex] == INDEX_NONE)
+                continue;
+
+            FMorphTargetDelta Delta = SourceLOD.Vertices[SourceDeltaIds[MirrorIndex]];
+            Delta.SourceIdx = VertIndex;
+            Delta.PositionDelta[MirrorAxis] *= -1.f;
+            Delta.TangentZDelta[MirrorAxis] *= -1.f;
+            OutLOD.Vertices.Add(Delta);
+        }
+    }
+}
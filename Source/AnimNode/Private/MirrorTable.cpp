@@ -0,0 +1,690 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MirrorTable.h"
+#include "MirrorBoneKernels.h"
+#include "Animation/Skeleton.h"
+#include "ReferenceSkeleton.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#if WITH_EDITOR
+#include "DerivedDataCacheInterface.h"
+#endif
+
+// Change this guid whenever the table generation or its serialized layout changes
+#define MIRRORTABLE_DERIVEDDATA_VER TEXT("9B2E6F14A7C34D85B1F0E3A6C8D27E49")
+
+void FMirrorTable::Reset()
+{
+    DerivedDataKey.Empty();
+    SkeletonFingerprint.Empty();
+    BonePairs.Empty();
+    CurvePairs.Empty();
+    UnpairedBones.Empty();
+    UnpairedCurves.Empty();
+}
+
+bool FMirrorTable::Serialize(FArchive& Ar)
+{
+    // The payload goes through a blob so tables baked by an older layout can be skipped and rebuilt
+    FString Version(MIRRORTABLE_DERIVEDDATA_VER);
+    Ar << Version;
+
+    TArray<uint8> Payload;
+    if(Ar.IsSaving()){
+        FMemoryWriter Writer(Payload);
+        SerializePayload(Writer);
+    }
+
+    Ar << Payload;
+
+    if(Ar.IsLoading()){
+        Reset();
+        if(Version == MIRRORTABLE_DERIVEDDATA_VER){
+            FMemoryReader Reader(Payload);
+            SerializePayload(Reader);
+        }
+    }
+    return true;
+}
+
+void FMirrorTable::SerializePayload(FArchive& Ar)
+{
+    Ar << DerivedDataKey;
+    Ar << SkeletonFingerprint;
+    Ar << BonePairs;
+    Ar << CurvePairs;
+    Ar << UnpairedBones;
+    Ar << UnpairedCurves;
+}
+
+FMirrorTableBuilder::FMirrorTableBuilder(MirrorPlane InMirPlane, const FString& InSearchReplaceKeyPair, const FString& InSkipCheckKeyStr)
+    : MirPlane(InMirPlane)
+    , SearchReplaceKeyPair(InSearchReplaceKeyPair)
+    , SkipCheckKeyStr(InSkipCheckKeyStr)
+    , ZeroPosId(0)
+{
+}
+
+void FMirrorTableBuilder::Build(const TArray<FName>& InBoneNames, const TArray<FTransform>& InComponentSpaceRefPose, const TArray<FName>& AllCurves, FMirrorTable& OutTable)
+{
+    check(InBoneNames.Num() == InComponentSpaceRefPose.Num());
+
+    BoneNames = InBoneNames;
+    ComponentSpaceRefPose = InComponentSpaceRefPose;
+    BoneIndexMap.Empty(BoneNames.Num());
+    for(int32 i = 0; i < BoneNames.Num(); i++)
+        BoneIndexMap.Emplace(BoneNames[i], i);
+
+    GenerateInitialStatus();
+    GenerateSearchReplaceKey();
+    SplitStringStr(SkipCheckKeyStr, TEXT(","),  SkipCheckKeys);
+    GenerateMirrorBoneInfo();
+    GenerateFlippingRule();
+
+    //OutputMirrorFlippingRuleLog();
+    GenerateMirrorMorphTargetInfo(AllCurves);
+    GenerateMirrorTable(AllCurves, OutTable);
+}
+
+void FMirrorTableBuilder::Build(const FReferenceSkeleton& RefSkel, const TArray<FName>& AllCurves, FMirrorTable& OutTable)
+{
+    const TArray<FMeshBoneInfo>& BoneInfo = RefSkel.GetRefBoneInfo();
+    const TArray<FTransform>& RefPose = RefSkel.GetRefBonePose();
+    int32 BoneNum = RefSkel.GetNum();
+
+    // Parents always come before their children in the reference skeleton
+    TArray<FName> InBoneNames;
+    TArray<FTransform> InComponentSpaceRefPose;
+    InBoneNames.SetNum(BoneNum);
+    InComponentSpaceRefPose.SetNum(BoneNum);
+    for(int32 i = 0; i < BoneNum; i++){
+        InBoneNames[i] = BoneInfo[i].Name;
+        int32 ParentIndex = BoneInfo[i].ParentIndex;
+        if(ParentIndex == INDEX_NONE)
+            InComponentSpaceRefPose[i] = RefPose[i];
+        else
+            InComponentSpaceRefPose[i] = RefPose[i] * InComponentSpaceRefPose[ParentIndex];
+    }
+
+    Build(InBoneNames, InComponentSpaceRefPose, AllCurves, OutTable);
+    OutTable.DerivedDataKey = GetDerivedDataKey(RefSkel, AllCurves);
+}
+
+void FMirrorTableBuilder::BuildCached(const FReferenceSkeleton& RefSkel, const TArray<FName>& AllCurves, FMirrorTable& InOutTable, const FString& DebugContext)
+{
+    FString Key = GetDerivedDataKey(RefSkel, AllCurves);
+    if(InOutTable.DerivedDataKey == Key)
+        return;
+
+#if WITH_EDITOR
+    if(GetFromDerivedDataCache(Key, InOutTable, DebugContext))
+        return;
+#endif
+
+    InOutTable.Reset();
+    Build(RefSkel, AllCurves, InOutTable);
+
+#if WITH_EDITOR
+    PutInDerivedDataCache(InOutTable, DebugContext);
+#endif
+}
+
+void FMirrorTableBuilder::BuildCached(const USkeleton* Skel, FMirrorTable& InOutTable, bool bFullCheck)
+{
+    // Hashing every bone is only needed when the cheap fingerprint no longer matches
+    FString Fingerprint = GetSkeletonFingerprint(Skel);
+    if(!bFullCheck && !InOutTable.DerivedDataKey.IsEmpty() && InOutTable.SkeletonFingerprint == Fingerprint)
+        return;
+
+    TArray<FName> AllCurves;
+    GetSkeletonCurveNames(Skel, AllCurves);
+    BuildCached(Skel->GetReferenceSkeleton(), AllCurves, InOutTable, Skel->GetPathName());
+    InOutTable.SkeletonFingerprint = Fingerprint;
+}
+
+FString FMirrorTableBuilder::GetSkeletonFingerprint(const USkeleton* Skel) const
+{
+    const FSmartNameMapping* Mapping = Skel->GetSmartNameContainer(USkeleton::AnimCurveMappingName);
+    int32 NumCurves = Mapping ? Mapping->GetNumNames() : 0;
+    uint32 SettingsHash = HashCombine(GetTypeHash((uint8)MirPlane), HashCombine(GetTypeHash(SearchReplaceKeyPair), GetTypeHash(SkipCheckKeyStr)));
+    return FString::Printf(TEXT("%s_%d_%d_%08x"), *Skel->GetGuid().ToString(), Skel->GetReferenceSkeleton().GetNum(), NumCurves, SettingsHash);
+}
+
+FString FMirrorTableBuilder::GetDerivedDataKey(const FReferenceSkeleton& RefSkel, const TArray<FName>& AllCurves) const
+{
+    TArray<uint8> KeyData;
+    FMemoryWriter Ar(KeyData);
+
+    uint8 PlaneVal = (uint8)MirPlane;
+    FString KeyPairStr = SearchReplaceKeyPair;
+    FString SkipStr = SkipCheckKeyStr;
+    Ar << PlaneVal << KeyPairStr << SkipStr;
+
+    const TArray<FMeshBoneInfo>& BoneInfo = RefSkel.GetRefBoneInfo();
+    const TArray<FTransform>& RefPose = RefSkel.GetRefBonePose();
+    for(int32 i = 0; i < RefSkel.GetNum(); i++){
+        FString BoneName = BoneInfo[i].Name.ToString();
+        int32 ParentIndex = BoneInfo[i].ParentIndex;
+        FTransform BonePose = RefPose[i];
+        Ar << BoneName << ParentIndex << BonePose;
+    }
+
+    for(FName Curve : AllCurves){
+        FString CurveName = Curve.ToString();
+        Ar << CurveName;
+    }
+
+    FSHAHash Hash;
+    FSHA1::HashBuffer(KeyData.GetData(), KeyData.Num(), Hash.Hash);
+    return FString::Printf(TEXT("MIRRORTABLE_%s_%s"), MIRRORTABLE_DERIVEDDATA_VER, *Hash.ToString());
+}
+
+void FMirrorTableBuilder::GetSkeletonCurveNames(const USkeleton* Skel, TArray<FName>& OutCurves)
+{
+    OutCurves.Empty();
+    const FSmartNameMapping* Mapping = Skel->GetSmartNameContainer(USkeleton::AnimCurveMappingName);
+    if(Mapping)
+        Mapping->FillNameArray(OutCurves);
+
+    // Mapping order is not stable, the key and the pairing must not depend on it
+    OutCurves.Sort(FNameLexicalLess());
+}
+
+int32 FMirrorTableBuilder::GetMirrorAxis(MirrorPlane InMirPlane)
+{
+    if(InMirPlane == MirrorPlane::XZ_Plane)
+        return 1;
+    else if(InMirPlane == MirrorPlane::YZ_Plane)
+        return 0;
+    return 2;
+}
+
+#if WITH_EDITOR
+bool FMirrorTableBuilder::GetFromDerivedDataCache(const FString& Key, FMirrorTable& OutTable, const FString& DebugContext)
+{
+    TArray<uint8> Data;
+    if(!GetDerivedDataCacheRef().GetSynchronous(*Key, Data, DebugContext))
+        return false;
+
+    FMemoryReader Ar(Data, true);
+    OutTable.Serialize(Ar);
+    return OutTable.DerivedDataKey == Key;
+}
+
+void FMirrorTableBuilder::PutInDerivedDataCache(FMirrorTable& Table, const FString& DebugContext)
+{
+    TArray<uint8> Data;
+    FMemoryWriter Ar(Data, true);
+    Table.Serialize(Ar);
+    GetDerivedDataCacheRef().Put(*Table.DerivedDataKey, Data, DebugContext, true);
+}
+#endif
+
+void FMirrorTableBuilder::SplitStringStr(const FString& InStr, const FString& InS, TArray<FString>& OutList)
+{
+    OutList.Empty();
+
+    FString ChkStr = InStr.Replace(TEXT(" "), TEXT(""));
+    FString LtS, RtS;
+
+    OutList.Add(ChkStr);
+    bool bIsSplited = true;
+    while(bIsSplited){
+        bIsSplited = ChkStr.Split(InS, &LtS, &RtS);
+        if(bIsSplited){
+            OutList[OutList.Num() - 1] = LtS;
+            if(RtS != TEXT(""))
+                OutList.Add(RtS);
+            
+            ChkStr = RtS;
+        }
+    }
+}
+
+bool FMirrorTableBuilder::CheckIsSkippedName(const FName& InName)
+{
+    bool bIsSkip = false;
+    FString InNameStr = InName.ToString();
+    if(SkipCheckKeys.Num() > 0){
+        for(FString SkipKey : SkipCheckKeys){
+            if(InNameStr.Contains(SkipKey))
+                bIsSkip = true;
+        }
+    }
+    return bIsSkip;
+}
+
+void FMirrorTableBuilder::GenerateInitialStatus()
+{
+    //UE_LOG(LogTemp, Warning, TEXT("Renew Status: %d"), MirPlane);
+    TranslateFlippingValue.Empty();
+    RotateFlippingValue.Empty();
+    ZeroPosId = 0;
+    TranslateFlippingValue.Init(1, 3);
+    RotateFlippingValue.Init(1, 3);
+    if(MirPlane == MirrorPlane::XZ_Plane){
+        TranslateFlippingValue[1] = -1;
+        RotateFlippingValue[0] = -1;
+        RotateFlippingValue[2] = -1;
+        ZeroPosId = 1; //13;
+    }
+    else if(MirPlane == MirrorPlane::YZ_Plane){
+        TranslateFlippingValue[0] = -1;
+        RotateFlippingValue[1] = -1;
+        RotateFlippingValue[2] = -1;
+        ZeroPosId = 0; //12;
+    }
+    else{
+        TranslateFlippingValue[2] = -1;
+        RotateFlippingValue[0] = -1;
+        RotateFlippingValue[1] = -1;
+        ZeroPosId = 2; //14;
+    }
+}
+
+void FMirrorTableBuilder::GenerateSearchReplaceKey()
+{
+    SplitStringStr(SearchReplaceKeyPair, TEXT(","),  SearchKeys);
+    int Num = SearchKeys.Num();
+    if(Num % 2 == 1)
+        SearchKeys.RemoveAt(Num - 1);
+    
+    SearchInfo.Empty();
+    for(int i = 0; i < SearchKeys.Num(); i += 2){
+        SearchInfo.Emplace(SearchKeys[i], SearchKeys[i + 1]);
+        SearchInfo.Emplace(SearchKeys[i + 1], SearchKeys[i]);
+    }
+
+    SearchKeys.Sort(
+        [](const FString& A, const FString& B){
+            return A.Len() > B.Len();
+        }
+    );
+}
+
+FName FMirrorTableBuilder::GetMirrorBone(const FName& InBone, int32& OutBoneID)
+{
+    FString InBoneStr = InBone.ToString();
+    FString OutBoneStr, ReplaceKey;
+    FName OutBone;
+    for(FString SearchKey : SearchKeys){
+        if(InBoneStr.Contains(SearchKey)){
+            ReplaceKey = SearchInfo[SearchKey];
+            OutBoneStr = InBoneStr.Replace(*SearchKey, *ReplaceKey);
+            const int32* BoneID = BoneIndexMap.Find(FName(*OutBoneStr));
+            if(BoneID){
+                OutBone = FName(*OutBoneStr);
+                OutBoneID = *BoneID;
+                break;
+            }
+        }
+    }
+    return OutBone;
+}
+
+void FMirrorTableBuilder::GenerateMirrorBoneInfo()
+{
+    MirrorBoneInfo.Empty();
+
+    if(SearchInfo.Num() == 0)
+        return;
+
+    int32 BoneNum = BoneNames.Num();
+    for(int32 i = 0; i < BoneNum; i++){ 
+        FName BoneName = BoneNames[i];
+        if(MirrorBoneInfo.Contains(BoneName))
+            continue;
+
+        if(CheckIsSkippedName(BoneName))
+            continue;
+
+        int32 MirrorID;
+        FName MirrorBoneName = GetMirrorBone(BoneName, MirrorID);
+        // A bone joins one pair only, pairs may be mirrored concurrently. A bone whose
+        // mirror was already taken by an earlier pair is left unpaired.
+        if(!MirrorBoneName.IsNone() && MirrorBoneInfo.Contains(MirrorBoneName))
+            continue;
+
+        if(MirrorBoneName.IsNone()){
+            const FTransform& Trans = ComponentSpaceRefPose[i];
+            FMatrix WorldTM = Trans.ToMatrixWithScale();
+            if(UKismetMathLibrary::Abs(WorldTM.M[3][ZeroPosId]) < 0.001){
+                MirrorBoneName = BoneName;
+                MirrorID = i;
+                MirrorBoneInfo.Emplace(BoneName, MirrorBoneName);
+            }
+        }
+        if(MirrorBoneName.IsNone())
+            continue;
+        
+        MirrorBoneInfo.Emplace(BoneName, MirrorBoneName);
+        MirrorBoneInfo.Emplace(MirrorBoneName, BoneName);
+    }
+}
+
+void FMirrorTableBuilder::GenerateFlippingRule()
+{
+    FlippingRule.Empty();
+    OperateBones.Empty();
+    if(MirrorBoneInfo.Num() == 0)
+        return;
+
+    for(TPair<FName, FName>& KVP : MirrorBoneInfo){
+        FName ABone = KVP.Key;
+        FName BBone = KVP.Value;
+
+        if(FlippingRule.Contains(BBone))
+            continue;
+
+        OperateBones.Add(ABone);
+        GenerateSingleBoneFlippingRule(ABone, BBone);
+    }
+}
+
+void FMirrorTableBuilder::GenerateSingleBoneFlippingRule(const FName& ABone, const FName& BBone)
+{
+    TArray<int> AxisRepInfo[2];
+    TArray<FName> Objs = {ABone, BBone};
+    for(int i = 0; i < Objs.Num(); i++)
+        GenerateBoneAxisRepInfo(Objs[i], AxisRepInfo[i]);
+
+    TArray<int> AlignAxisRepInfo[2];
+    GenerateAlignAxisRepInfo(AxisRepInfo, AlignAxisRepInfo);
+
+    TArray<int> RotFlipVals[2];
+    for(int i = 0; i < 2; i++)
+        GenerateRotationFlippingValues(AlignAxisRepInfo[i], RotFlipVals[i]);
+        
+    GenerateSingleBoneFlippingRuleDetail(Objs, AxisRepInfo, RotFlipVals);
+}
+
+void FMirrorTableBuilder::GenerateBoneAxisRepInfo(const FName& InBone, TArray<int>& AxisRepInfo)
+{
+    int32 BoneId = BoneIndexMap[InBone];
+    const FTransform& Trans = ComponentSpaceRefPose[BoneId];
+    FMatrix WorldTM = Trans.ToMatrixWithScale();
+    
+    GenerateAxisRepInfoFromMatrix(WorldTM, AxisRepInfo);
+}
+
+void FMirrorTableBuilder::GenerateAxisRepInfoFromMatrix(const FMatrix& TM, TArray<int>& AxisRepInfo)
+{
+    TArray<int> CheckList;
+    TArray<int> InvalidIds;
+    for(int j = 0; j < 3; j++){
+        float AxisMaxVal = 0;
+        int AxisMaxId = 0;
+        int AbsAxisMaxId = 0;
+        for(int k = 0; k < 3; k++){
+            float Val = TM.M[k][j];
+            float AbsVal = UKismetMathLibrary::Abs(Val);
+            if(AbsVal > AxisMaxVal){
+                AxisMaxVal = AbsVal;
+                AxisMaxId = (k + 1) * int(Val / AbsVal);
+            }
+        }
+
+        AxisRepInfo.Add(AxisMaxId);
+        AbsAxisMaxId = UKismetMathLibrary::Abs(AxisMaxId);
+        if(CheckList.Num() > 0 && CheckList.Contains(AbsAxisMaxId))
+            InvalidIds.Add(AbsAxisMaxId);
+        
+        CheckList.Add(AbsAxisMaxId);
+    }
+
+    if(InvalidIds.Num() > 0){
+        TArray<int> KeepIds;
+        TArray<int> ValidVals;
+        for(int InvalidId : InvalidIds){
+            int AxisMaxVal = 0;
+            int KeepId = -1;
+            int ValidVal = -1;
+            for(int j = 0; j < 3; j++){
+                if(KeepIds.Contains(j))
+                    continue;
+
+                int CurAbsAxisRepId = UKismetMathLibrary::Abs(AxisRepInfo[j]);
+                if(CurAbsAxisRepId == InvalidId){
+                    float AbsVal = UKismetMathLibrary::Abs(TM.M[InvalidId - 1][j]);
+                    if(AbsVal > AxisMaxVal){
+                        AxisMaxVal = AbsVal;
+                        KeepId = j;
+                        ValidVal = CurAbsAxisRepId;
+                    }
+                }
+                else{
+                    KeepIds.Add(j);
+                    ValidVals.Add(CurAbsAxisRepId);
+                }
+            }
+
+            KeepIds.Add(KeepId);
+            if(ValidVals.Contains(UKismetMathLibrary::Abs(AxisRepInfo[KeepId]))){
+                int k = 1;
+                for(; k < 4; k++){
+                    if(!ValidVals.Contains(k))
+                        break;
+                }
+
+                float Val = TM.M[k - 1][KeepId];
+                AxisRepInfo[KeepId] = int(Val / UKismetMathLibrary::Abs(Val)) * k;
+            }
+
+            ValidVals.Add(UKismetMathLibrary::Abs(AxisRepInfo[KeepId]));
+        }
+
+        for(int j = 0; j < 3; j++){
+            if(!KeepIds.Contains(j)){
+                int k = 1;
+                for(; k < 4; k++){
+                    if(!ValidVals.Contains(k))
+                        break;
+                }
+                float Val = TM.M[k - 1][j];
+                AxisRepInfo[j] = int(Val / UKismetMathLibrary::Abs(Val)) * k;
+            }
+        }
+    }
+}
+
+void FMirrorTableBuilder::GenerateAlignAxisRepInfo(const TArray<int> (&AxisRepInfo)[2], TArray<int>(&AlignAxisRepInfo)[2])
+{
+    for(int i = 0; i < 2; i++){
+        for(int Val : AxisRepInfo[i])
+            AlignAxisRepInfo[i].Add(Val);
+    }
+
+    if(AlignAxisRepInfo[0][0] * AlignAxisRepInfo[1][0] < 0){
+        AlignAxisRepInfo[1][0] *= -1;
+        AlignAxisRepInfo[1][1] *= -1;
+        AlignAxisRepInfo[1][2] *= -1;
+    } 
+}
+
+void FMirrorTableBuilder::GenerateRotationFlippingValues(const TArray<int>& AlignAxisRepInfo, TArray<int>& RotFlipVals)
+{
+    for(int j = 0; j < 3; j++){
+        int CVal = 1;
+
+        int CId = AlignAxisRepInfo[j];
+        int OriNId = (int)(UKismetMathLibrary::Abs(CId) - 1 + 1) % 3 + 1;
+        int OriNnId = (int)(UKismetMathLibrary::Abs(CId) - 1 + 2) % 3 + 1;
+
+        int NId = AlignAxisRepInfo[(j + 1) % 3];
+        int NnId = AlignAxisRepInfo[(j + 2) % 3];
+
+        if(OriNId == UKismetMathLibrary::Abs(NId)){
+            if(OriNId == -NId)
+                CVal *= -1;
+            if(OriNnId == -NnId)
+                CVal *= -1;
+        }
+        else{
+            CVal *= -1;
+            if(OriNId * NId < 0)
+                CVal *= -1;
+            if(OriNnId * NnId < 0)
+                CVal *= -1;
+        }
+
+        RotFlipVals.Add(CVal);
+    }
+}
+
+void FMirrorTableBuilder::GenerateSingleBoneFlippingRuleDetail(const TArray<FName>& Objs, const TArray<int> (&AxisRepInfo)[2], const TArray<int> (&RotFlipVals)[2])
+{
+    TArray<int> OutTranslateFlipVals;
+    TArray<int> OutRotateFlipVals;
+    for(int i = 0; i < 3; i++){
+        int TVal = AxisRepInfo[0][i] * AxisRepInfo[1][i] * TranslateFlippingValue[i];
+        int RVal = RotFlipVals[0][i] * RotFlipVals[1][i] * RotateFlippingValue[i];
+        OutTranslateFlipVals.Add(TVal / (int)UKismetMathLibrary::Abs(TVal));
+        OutRotateFlipVals.Add(RVal);
+    }
+
+    for(int i = 0; i < Objs.Num(); i++){
+        FName AObj = Objs[i];
+        FName BObj = Objs[(i + 1) % 2];
+        
+        FMirrorFlippingRuleData Data;
+        Data.MirrorBone = BObj;
+        for(int j = 0; j < 6; j++){
+            Data.FlipAttrInfo.Add(j);
+            Data.FlipValInfo.Add(1);
+        }
+
+        for(int j = 0; j < 3; j++){
+            int OriTAttrId = UKismetMathLibrary::Abs(AxisRepInfo[i][j]) - 1;
+            int OriRAttrId = UKismetMathLibrary::Abs(AxisRepInfo[i][j]) - 1 + 3;
+            int ToTAttrId = UKismetMathLibrary::Abs(AxisRepInfo[(i + 1) % 2][j]) - 1;
+            int ToRAttrId = UKismetMathLibrary::Abs(AxisRepInfo[(i + 1) % 2][j]) - 1 + 3;
+            Data.FlipValInfo[OriTAttrId] = OutTranslateFlipVals[j];
+            Data.FlipValInfo[OriRAttrId] = OutRotateFlipVals[j];
+            Data.FlipAttrInfo[OriTAttrId] = ToTAttrId;
+            Data.FlipAttrInfo[OriRAttrId] = ToRAttrId;
+        }
+
+        FlippingRule.Emplace(AObj, Data);
+    }
+}
+
+void FMirrorTableBuilder::OutputMirrorFlippingRuleLog()
+{
+    for(TPair<FName, FMirrorFlippingRuleData>& KVP : FlippingRule){
+        FName ABone = KVP.Key;
+        FMirrorFlippingRuleData Data = KVP.Value;
+        
+        UE_LOG(LogTemp, Warning, TEXT("Bone: %s Mirror: %s "), *ABone.ToString(), *(Data.MirrorBone).ToString());
+        UE_LOG(LogTemp, Warning, TEXT("    FlipAttrs: %s"), *TArrayOutput(Data.FlipAttrInfo));
+        UE_LOG(LogTemp, Warning, TEXT("    FlipVals:  %s"), *TArrayOutput(Data.FlipValInfo));
+    }
+}
+
+FString FMirrorTableBuilder::TArrayOutput(const TArray<int> InArray)
+{
+    FString Out = TEXT("Array: ");
+    for(int Val : InArray)
+        Out += FString::Printf(TEXT("%d "), Val);
+
+    return Out;
+}
+
+void FMirrorTableBuilder::GenerateMirrorMorphTargetInfo(const TArray<FName>& AllCurves)
+{
+    FlippingMorphTargetRule.Empty();
+
+    for(FName ACurve : AllCurves){
+        if(FlippingMorphTargetRule.Contains(ACurve))
+            continue;
+
+        if(CheckIsSkippedName(ACurve))
+            continue;
+        
+        FName BCurve = GetMirrorAnimCurve(ACurve, AllCurves);
+        if(!BCurve.IsNone()){
+            FlippingMorphTargetRule.Emplace(ACurve, BCurve);
+            FlippingMorphTargetRule.Emplace(BCurve, ACurve);
+        }
+    }
+}
+
+FName FMirrorTableBuilder::GetMirrorAnimCurve(const FName& InCurve, const TArray<FName>& AllCurves)
+{
+    FString InStr = InCurve.ToString();
+    FString OutStr, ReplaceKey;
+    FName OutCurve;
+    for(FString SearchKey : SearchKeys){
+        if(InStr.Contains(SearchKey)){
+            ReplaceKey = SearchInfo[SearchKey];
+            OutStr = InStr.Replace(*SearchKey, *ReplaceKey);
+            if(AllCurves.Contains(FName(*OutStr))){
+                OutCurve = FName(*OutStr);
+                break;
+            }
+        }
+    }
+    return OutCurve;
+}
+
+void FMirrorTableBuilder::GenerateMirrorTable(const TArray<FName>& AllCurves, FMirrorTable& OutTable)
+{
+    OutTable.Reset();
+
+    for(FName ABone : OperateBones){
+        FName BBone = FlippingRule[ABone].MirrorBone;
+
+        FMirrorBonePair Pair;
+        Pair.ABone = ABone;
+        Pair.BBone = BBone;
+        Pair.ABoneIndex = BoneIndexMap[ABone];
+        Pair.BBoneIndex = BoneIndexMap[BBone];
+        Pair.FlippingRule = FlippingRule[BBone];
+        Pair.KernelPattern = FMirrorBoneKernelBatch::GetKernelPattern(Pair.FlippingRule);
+        OutTable.BonePairs.Add(Pair);
+    }
+
+    OutTable.BonePairs.StableSort(
+        [](const FMirrorBonePair& A, const FMirrorBonePair& B){
+            return A.KernelPattern < B.KernelPattern;
+        }
+    );
+
+    for(FName BoneName : BoneNames){
+        if(!MirrorBoneInfo.Contains(BoneName) && !CheckIsSkippedName(BoneName))
+            OutTable.UnpairedBones.Add(BoneName);
+    }
+
+    TSet<FName> AddedCurves;
+    for(FName ACurve : AllCurves){
+        if(AddedCurves.Contains(ACurve))
+            continue;
+
+        // Pairs must not share a curve, the node swaps them in place. A curve whose
+        // mirror was already taken by an earlier pair is reported as unpaired.
+        const FName* BCurve = FlippingMorphTargetRule.Find(ACurve);
+        if(BCurve && !AddedCurves.Contains(*BCurve)){
+            FMirrorCurvePair Pair;
+            Pair.ACurve = ACurve;
+            Pair.BCurve = *BCurve;
+            OutTable.CurvePairs.Add(Pair);
+            AddedCurves.Add(ACurve);
+            AddedCurves.Add(*BCurve);
+            continue;
+        }
+
+        // Only curves naming a side are expected to find a mirror
+        if(CheckIsSkippedName(ACurve))
+            continue;
+
+        FString CurveStr = ACurve.ToString();
+        for(const FString& SearchKey : SearchKeys){
+            if(CurveStr.Contains(SearchKey)){
+                OutTable.UnpairedCurves.Add(ACurve);
+                break;
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -7,26 +7,11 @@
 #include "Animation/AnimNodeBase.h"
 #include "Animation/InputScaleBias.h"
 #include "Animation/AnimInstanceProxy.h"
+#include "MirrorTable.h"
+#include "MirrorBoneKernels.h"
 #include "AnimNode_Mirror.generated.h"
 
 
-UENUM(BlueprintType)
-enum class MirrorPlane : uint8
-{
-	XZ_Plane = 0,
-	YZ_Plane = 1,
-	XY_Plane = 2,
-};
-
-struct FMirrorFlippingRuleData
-{
-	FName MirrorBone;
-
-	TArray<int> FlipAttrInfo;
-
-	TArray<int> FlipValInfo;
-};
-
 USTRUCT(BlueprintInternalUseOnly)
 struct ANIMNODE_API FAnimNode_Mirror : public FAnimNode_Base
 {
@@ -47,6 +32,26 @@ struct ANIMNODE_API FAnimNode_Mirror : public FAnimNode_Base
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings, meta = (PinShownByDefault))
 	bool bEnable;
 
+	/** Crossfade time between the input and the mirrored pose when bEnable changes, 0 switches instantly */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings, meta = (ClampMin = "0.0"))
+	float BlendTime;
+
+	/** Mirror the pairs across task graph workers when there are at least ParallelPairThreshold of them */
+	UPROPERTY(EditAnywhere, Category=Performance)
+	bool bParallelMirror;
+
+	/** Not measured in engine yet, -run=MirrorBenchmark suggests a value for the machine it runs on */
+	UPROPERTY(EditAnywhere, Category=Performance, meta = (EditCondition = "bParallelMirror", ClampMin = "1"))
+	int32 ParallelPairThreshold;
+
+	/** Minimum pairs handed to one worker, rounded up to whole cache lines of pair data */
+	UPROPERTY(EditAnywhere, Category=Performance, meta = (EditCondition = "bParallelMirror", ClampMin = "1"))
+	int32 ParallelChunkPairs;
+
+	/** Baked for the target skeleton when the anim blueprint compiles, rebuilt on initialize if stale */
+	UPROPERTY()
+	FMirrorTable MirrorTable;
+
 public:
 	FAnimNode_Mirror();
 
@@ -55,43 +60,19 @@ public:
 	virtual void Update_AnyThread(const FAnimationUpdateContext& Context) override;
 	virtual void Evaluate_AnyThread(FPoseContext& Context) override;
 
+	/** Brings MirrorTable up to date for Skel, see FMirrorTableBuilder::BuildCached */
+	void BuildMirrorTable(const USkeleton* Skel, bool bFullCheck = false);
+	void BuildMirrorTable(const USkeleton* Skel, FMirrorTable& InOutTable, bool bFullCheck = false) const;
+	const FMirrorTable& GetMirrorTable() const { return MirrorTable; }
+
 private:
-	TMap<FString, FString> SearchInfo;
-	TMap<FName, FName> MirrorBoneInfo;
-	TMap<FName, FMirrorFlippingRuleData> FlippingRule;
-	TArray<FName> OperateBones;
-	TMap<FName, FName> FlippingMorphTargetRule;
-
-	TArray<int> TranslateFlippingValue;
-	TArray<int> RotateFlippingValue;
-	int ZeroPosId;
-
-	TArray<FString> SearchKeys;
-	TArray<FString> SkipCheckKeys;
-
-	void GenerateInitialStatus();
-	void GenerateSearchReplaceKey();
-	void GenerateMirrorBoneInfo(const FAnimationInitializeContext& Context);
-	void GenerateFlippingRule(const FAnimationInitializeContext& Context);
-
-	bool CheckIsSkippedName(const FName& InBone);
-
-	void SplitStringStr(const FString& InStr, const FString& InS, TArray<FString>& OutList);
-	FName GetMirrorBone(const FName& InBone, const FReferenceSkeleton& RefSkel, int32& OutBoneID);
-	void GenerateSingleBoneFlippingRule(const FAnimationInitializeContext& Context, const FName& ABone, const FName& BBone);//, TArray<int> (&FlipAttrInfo)[2], TArray<int> (&FlipValInfo)[2]);
-
-	void GenerateBoneAxisRepInfo(const FAnimationInitializeContext& Context, const FName& InBone, TArray<int>& AxisRepInfo);
-	void GenerateAxisRepInfoFromMatrix(const FMatrix& TM, TArray<int>& AxisRepInfo);
-
-	void GenerateAlignAxisRepInfo(const TArray<int> (&AxisRepInfo)[2], TArray<int>(&AlignAxisRepInfo)[2]);
-	void GenerateSingleBoneFlippingRuleDetail(const TArray<FName>& Objs, const TArray<int> (&AxisRepInfo)[2], const TArray<int> (&RotFlipVals)[2]);
-	void GenerateRotationFlippingValues(const TArray<int>& AlignAxisRepInfo, TArray<int>& RotFlipVals);
-
-	void OutputMirrorFlippingRuleLog();
-	FString TArrayOutput(const TArray<int> InArray);
-	//////////////////
-	void GenerateMirrorMorphTargetInfo(const FAnimationInitializeContext& Context);
-	FName GetMirrorAnimCurve(const FName& InCurve, const TArray<FName>& AllCurves);
+	/** Current blend towards the mirrored pose, driven by bEnable and BlendTime */
+	float MirrorWeight;
+
+	/** Table pairs resolved to compact pose indices of the current required bones */
+	FMirrorBoneKernelBatch BoneBatch;
+
+	void ResolveBoneBatch(const FBoneContainer& BoneContainer);
 
 	void DoMirrorBones(FPoseContext& Output);
 	void DoMirrorMorphTargets(FPoseContext& Output);
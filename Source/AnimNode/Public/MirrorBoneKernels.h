@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MirrorTable.h"
+
+/**
+ * Kernel patterns encode the axis permutation of a flipping rule (6 cases, shared by
+ * translation and rotation) and its three translation signs (8 cases). The rotation signs
+ * follow from those, see GenerateSingleBoneFlippingRuleDetail. Rules that don't fit, e.g.
+ * from degenerate reference poses, fall back to the generic kernel.
+ */
+#define MIRROR_KERNEL_PATTERN_NUM 48
+#define MIRROR_KERNEL_PATTERN_GENERIC MIRROR_KERNEL_PATTERN_NUM
+
+struct FMirrorBoneKernelPair
+{
+	/** Indices into the transform array handed to the kernels */
+	int32 AIndex;
+
+	int32 BIndex;
+
+	/** Into FMirrorBoneKernelBatch::GenericRules, only used by the generic kernel */
+	int32 GenericRuleIndex;
+
+	FTransform ARefPose;
+
+	FTransform BRefPose;
+};
+
+struct FMirrorBoneKernelGroup
+{
+	uint16 Pattern;
+
+	int32 StartIndex;
+
+	int32 Num;
+};
+
+/**
+ * Pairs of a mirror table resolved against one transform array, grouped by kernel pattern.
+ * When no two pairs share a bone, any split of the pair list can run concurrently.
+ */
+struct ANIMNODE_API FMirrorBoneKernelBatch
+{
+	/** Cache line aligned so parallel chunks start on a line of their own */
+	TArray<FMirrorBoneKernelPair, TAlignedHeapAllocator<PLATFORM_CACHE_LINE_SIZE>> Pairs;
+
+	TArray<FMirrorBoneKernelGroup> Groups;
+
+	TArray<FMirrorFlippingRuleData> GenericRules;
+
+	/** Transform indices referenced by the pairs so far */
+	TBitArray<> UsedIndices;
+
+	/** False once two pairs share a transform, ExecuteParallel then runs single threaded */
+	bool bPairsDisjoint = true;
+
+public:
+	void Reset();
+
+	/** Pairs have to be added in pattern order, as FMirrorTable::BonePairs already are */
+	void AddPair(const FMirrorBonePair& TablePair, int32 AIndex, int32 BIndex, const FTransform& ARefPose, const FTransform& BRefPose);
+
+	/**
+	 * Mirrors every pair in place, Bones holds the local transforms the indices refer to.
+	 * A Weight below 1 blends each pair between its input and mirrored pose.
+	 */
+	void Execute(TArrayView<FTransform> Bones, float Weight = 1.f) const;
+
+	/** Same as Execute, only for the pairs in [StartPair, EndPair) */
+	void ExecuteRange(TArrayView<FTransform> Bones, float Weight, int32 StartPair, int32 EndPair) const;
+
+	/**
+	 * Runs Execute across task graph workers, in chunks of at least MinChunkPairs rounded up to
+	 * whole cache lines. Falls back to Execute when pairs share a transform.
+	 */
+	void ExecuteParallel(TArrayView<FTransform> Bones, float Weight, int32 MinChunkPairs) const;
+
+	static uint16 GetKernelPattern(const FMirrorFlippingRuleData& Rule);
+};
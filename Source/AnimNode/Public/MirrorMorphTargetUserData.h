@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "Engine/AssetUserData.h"
+#include "MirrorTable.h"
+#include "MirrorMorphTargetUserData.generated.h"
+
+class UMorphTarget;
+struct FMorphTargetLODModel;
+
+USTRUCT()
+struct ANIMNODE_API FMirrorMorphTargetSections
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<int32> SectionIndices;
+};
+
+USTRUCT()
+struct ANIMNODE_API FMirrorMorphTargetPair
+{
+	GENERATED_BODY()
+
+	/** Keeps its deltas */
+	UPROPERTY(VisibleAnywhere, Category=Mirror)
+	UMorphTarget* SourceMorphTarget = nullptr;
+
+	/** Saved without deltas and rebuilt from SourceMorphTarget on load */
+	UPROPERTY(VisibleAnywhere, Category=Mirror)
+	UMorphTarget* MirroredMorphTarget = nullptr;
+
+	/** Per LOD, the render sections MirroredMorphTarget affected when it was imported */
+	UPROPERTY()
+	TArray<FMirrorMorphTargetSections> LODSectionIndices;
+};
+
+USTRUCT()
+struct ANIMNODE_API FMirrorVertexSymmetryMap
+{
+	GENERATED_BODY()
+
+	/** Per render vertex of the LOD, the vertex at its mirrored position or INDEX_NONE */
+	UPROPERTY()
+	TArray<int32> MirrorVertexIndices;
+};
+
+/**
+ * Added to a skeletal mesh whose symmetric morph targets store only one side.
+ * The other side is rebuilt while the package loads: in Serialize when both sides are already
+ * serialized, as preload dependencies guarantee for cooked packages, otherwise in PostLoad.
+ */
+UCLASS()
+class ANIMNODE_API UMirrorMorphTargetUserData : public UAssetUserData
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, Category=Mirror)
+	MirrorPlane MirPlane;
+
+	UPROPERTY(VisibleAnywhere, Category=Mirror)
+	TArray<FMirrorMorphTargetPair> Pairs;
+
+	UPROPERTY()
+	TArray<FMirrorVertexSymmetryMap> LODSymmetryMaps;
+
+	virtual void GetPreloadDependencies(TArray<UObject*>& OutDeps) override;
+	virtual void Serialize(FArchive& Ar) override;
+	virtual void PostLoad() override;
+	virtual void PreSave(const class ITargetPlatform* TargetPlatform) override;
+
+	void RebuildMirroredMorphTargets();
+	void StripMirroredMorphTargets();
+
+	/** Mirrors the deltas of Source through the symmetry maps, section indices are left to the caller */
+	static void MirrorMorphTargetDeltas(const UMorphTarget* Source, const TArray<FMirrorVertexSymmetryMap>& SymmetryMaps, MirrorPlane InMirPlane, TArray<FMorphTargetLODModel>& OutLODModels);
+
+private:
+	/** Set while stripped deltas wait for the save to finish, whether it succeeds or not */
+	bool bRestorePending = false;
+
+	/** Set once the current load has rebuilt the mirrored deltas */
+	bool bRebuiltOnLoad = false;
+
+	bool AreMorphTargetsSerialized() const;
+};
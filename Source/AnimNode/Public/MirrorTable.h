@@ -0,0 +1,197 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "ReferenceSkeleton.h"
+#include "MirrorTable.generated.h"
+
+class USkeleton;
+
+UENUM(BlueprintType)
+enum class MirrorPlane : uint8
+{
+	XZ_Plane = 0,
+	YZ_Plane = 1,
+	XY_Plane = 2,
+};
+
+struct FMirrorFlippingRuleData
+{
+	FName MirrorBone;
+
+	TArray<int> FlipAttrInfo;
+
+	TArray<int> FlipValInfo;
+
+	friend FArchive& operator<<(FArchive& Ar, FMirrorFlippingRuleData& Data)
+	{
+		Ar << Data.MirrorBone << Data.FlipAttrInfo << Data.FlipValInfo;
+		return Ar;
+	}
+};
+
+struct FMirrorBonePair
+{
+	FName ABone;
+
+	FName BBone;
+
+	/** Indices into the reference skeleton the table was built from */
+	int32 ABoneIndex;
+
+	int32 BBoneIndex;
+
+	/** Specialized kernel the pair is dispatched to, see FMirrorBoneKernelBatch */
+	uint16 KernelPattern;
+
+	/** Flipping rule of BBone, applied to both directions of the pair */
+	FMirrorFlippingRuleData FlippingRule;
+
+	friend FArchive& operator<<(FArchive& Ar, FMirrorBonePair& Pair)
+	{
+		Ar << Pair.ABone << Pair.BBone << Pair.ABoneIndex << Pair.BBoneIndex << Pair.KernelPattern << Pair.FlippingRule;
+		return Ar;
+	}
+};
+
+struct FMirrorCurvePair
+{
+	FName ACurve;
+
+	FName BCurve;
+
+	friend FArchive& operator<<(FArchive& Ar, FMirrorCurvePair& Pair)
+	{
+		Ar << Pair.ACurve << Pair.BCurve;
+		return Ar;
+	}
+};
+
+/**
+ * Compiled mirror pairing of a skeleton. Built by FMirrorTableBuilder, cached in the DDC
+ * and baked into the anim node when the anim blueprint compiles.
+ */
+USTRUCT()
+struct ANIMNODE_API FMirrorTable
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Key of the inputs the table was built from, empty when not built */
+	FString DerivedDataKey;
+
+	/** Cheap stand-in for DerivedDataKey, checked first when a node initializes */
+	FString SkeletonFingerprint;
+
+	/** Sorted by kernel pattern */
+	TArray<FMirrorBonePair> BonePairs;
+
+	TArray<FMirrorCurvePair> CurvePairs;
+
+	TArray<FName> UnpairedBones;
+
+	TArray<FName> UnpairedCurves;
+
+public:
+	void Reset();
+	bool Serialize(FArchive& Ar);
+
+private:
+	void SerializePayload(FArchive& Ar);
+};
+
+template<>
+struct TStructOpsTypeTraits<FMirrorTable> : public TStructOpsTypeTraitsBase2<FMirrorTable>
+{
+	enum
+	{
+		WithSerializer = true,
+	};
+};
+
+/**
+ * Generates the mirror table from bone names, reference transforms and curve names.
+ * Holds no UObject references, so separate builders can run on any thread.
+ */
+class ANIMNODE_API FMirrorTableBuilder
+{
+public:
+	FMirrorTableBuilder(MirrorPlane InMirPlane, const FString& InSearchReplaceKeyPair, const FString& InSkipCheckKeyStr);
+
+	/** ComponentSpaceRefPose holds one reference transform per bone, pair indices refer to BoneNames */
+	void Build(const TArray<FName>& BoneNames, const TArray<FTransform>& ComponentSpaceRefPose, const TArray<FName>& AllCurves, FMirrorTable& OutTable);
+	void Build(const FReferenceSkeleton& RefSkel, const TArray<FName>& AllCurves, FMirrorTable& OutTable);
+
+	/** Keeps InOutTable when its key still matches, otherwise loads it from the DDC or builds it */
+	void BuildCached(const FReferenceSkeleton& RefSkel, const TArray<FName>& AllCurves, FMirrorTable& InOutTable, const FString& DebugContext);
+
+	/**
+	 * Same for a skeleton, but trusts InOutTable without hashing the skeleton when its fingerprint
+	 * matches. bFullCheck always compares the full key, e.g. when the anim blueprint compiles.
+	 */
+	void BuildCached(const USkeleton* Skel, FMirrorTable& InOutTable, bool bFullCheck = false);
+
+	FString GetDerivedDataKey(const FReferenceSkeleton& RefSkel, const TArray<FName>& AllCurves) const;
+
+	/** Skeleton guid, bone and curve counts and the builder settings, no per bone work */
+	FString GetSkeletonFingerprint(const USkeleton* Skel) const;
+
+	static void GetSkeletonCurveNames(const USkeleton* Skel, TArray<FName>& OutCurves);
+
+	/** Component space axis negated by the plane, 0 for X */
+	static int32 GetMirrorAxis(MirrorPlane InMirPlane);
+
+#if WITH_EDITOR
+	static bool GetFromDerivedDataCache(const FString& Key, FMirrorTable& OutTable, const FString& DebugContext);
+	static void PutInDerivedDataCache(FMirrorTable& Table, const FString& DebugContext);
+#endif
+
+private:
+	MirrorPlane MirPlane;
+	FString SearchReplaceKeyPair;
+	FString SkipCheckKeyStr;
+
+	TMap<FString, FString> SearchInfo;
+	TMap<FName, FName> MirrorBoneInfo;
+	TMap<FName, FMirrorFlippingRuleData> FlippingRule;
+	TArray<FName> OperateBones;
+	TMap<FName, FName> FlippingMorphTargetRule;
+
+	TArray<int> TranslateFlippingValue;
+	TArray<int> RotateFlippingValue;
+	int ZeroPosId;
+
+	TArray<FString> SearchKeys;
+	TArray<FString> SkipCheckKeys;
+
+	TArray<FName> BoneNames;
+	TArray<FTransform> ComponentSpaceRefPose;
+	TMap<FName, int32> BoneIndexMap;
+
+	void GenerateInitialStatus();
+	void GenerateSearchReplaceKey();
+	void GenerateMirrorBoneInfo();
+	void GenerateFlippingRule();
+
+	bool CheckIsSkippedName(const FName& InBone);
+
+	void SplitStringStr(const FString& InStr, const FString& InS, TArray<FString>& OutList);
+	FName GetMirrorBone(const FName& InBone, int32& OutBoneID);
+	void GenerateSingleBoneFlippingRule(const FName& ABone, const FName& BBone);
+
+	void GenerateBoneAxisRepInfo(const FName& InBone, TArray<int>& AxisRepInfo);
+	void GenerateAxisRepInfoFromMatrix(const FMatrix& TM, TArray<int>& AxisRepInfo);
+
+	void GenerateAlignAxisRepInfo(const TArray<int> (&AxisRepInfo)[2], TArray<int>(&AlignAxisRepInfo)[2]);
+	void GenerateSingleBoneFlippingRuleDetail(const TArray<FName>& Objs, const TArray<int> (&AxisRepInfo)[2], const TArray<int> (&RotFlipVals)[2]);
+	void GenerateRotationFlippingValues(const TArray<int>& AlignAxisRepInfo, TArray<int>& RotFlipVals);
+
+	void OutputMirrorFlippingRuleLog();
+	FString TArrayOutput(const TArray<int> InArray);
+	//////////////////
+	void GenerateMirrorMorphTargetInfo(const TArray<FName>& AllCurves);
+	FName GetMirrorAnimCurve(const FName& InCurve, const TArray<FName>& AllCurves);
+
+	void GenerateMirrorTable(const TArray<FName>& AllCurves, FMirrorTable& OutTable);
+};
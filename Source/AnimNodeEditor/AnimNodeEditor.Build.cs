@@ -43,6 +43,9 @@ public class AnimNodeEditor : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"UnrealEd",
+				"AssetRegistry",
+				"Settings",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -1,20 +1,73 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "AnimNodeEditor.h"
+#include "ISettingsModule.h"
+#include "Editor.h"
+#include "Subsystems/ImportSubsystem.h"
+#include "Engine/SkeletalMesh.h"
+#include "MirrorMorphTargetSettings.h"
+#include "MirrorMorphTargetUtils.h"
 
 #define LOCTEXT_NAMESPACE "FAnimNodeEditorModule"
 
 void FAnimNodeEditorModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+	if(ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings")){
+		SettingsModule->RegisterSettings("Project", "Plugins", "MirrorAnimUtil",
+			LOCTEXT("MirrorSettingsName", "Mirror Anim Util"),
+			LOCTEXT("MirrorSettingsDescription", "Mirrored morph targets of imported skeletal meshes"),
+			GetMutableDefault<UMirrorMorphTargetSettings>());
+	}
+
+	// The import subsystem only exists once the editor is up
+	PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FAnimNodeEditorModule::OnPostEngineInit);
 }
 
 void FAnimNodeEditorModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+
+	if(GEditor && UObjectInitialized()){
+		if(UImportSubsystem* ImportSubsystem = GEditor->GetEditorSubsystem<UImportSubsystem>()){
+			ImportSubsystem->OnAssetPostImport.Remove(AssetPostImportHandle);
+			ImportSubsystem->OnAssetReimport.Remove(AssetReimportHandle);
+		}
+	}
+
+	if(ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
+		SettingsModule->UnregisterSettings("Project", "Plugins", "MirrorAnimUtil");
+}
+
+void FAnimNodeEditorModule::OnPostEngineInit()
+{
+	if(GEditor == nullptr)
+		return;
+
+	if(UImportSubsystem* ImportSubsystem = GEditor->GetEditorSubsystem<UImportSubsystem>()){
+		AssetPostImportHandle = ImportSubsystem->OnAssetPostImport.AddRaw(this, &FAnimNodeEditorModule::OnAssetPostImport);
+		AssetReimportHandle = ImportSubsystem->OnAssetReimport.AddRaw(this, &FAnimNodeEditorModule::OnAssetReimport);
+	}
+}
+
+void FAnimNodeEditorModule::OnAssetPostImport(UFactory* InFactory, UObject* InObject)
+{
+	OnAssetReimport(InObject);
+}
+
+void FAnimNodeEditorModule::OnAssetReimport(UObject* InObject)
+{
+	USkeletalMesh* Mesh = Cast<USkeletalMesh>(InObject);
+	const UMirrorMorphTargetSettings* Settings = GetDefault<UMirrorMorphTargetSettings>();
+	if(Mesh == nullptr || !Settings->bDeriveMirroredMorphTargetsOnImport)
+		return;
+
+	FMirrorMorphTargetReport Report;
+	FMirrorMorphTargetUtils::DeriveMirroredMorphTargets(Mesh, Settings, Report);
 }
 
 #undef LOCTEXT_NAMESPACE
 	
-IMPLEMENT_MODULE(FAnimNodeEditorModule, AnimNodeEditor)
\ No newline at end of file
+IMPLEMENT_MODULE(FAnimNodeEditorModule, AnimNodeEditor)
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+class UFactory;
+
 class FAnimNodeEditorModule : public IModuleInterface
 {
 public:
@@ -12,4 +14,13 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	void OnPostEngineInit();
+	void OnAssetPostImport(UFactory* InFactory, UObject* InObject);
+	void OnAssetReimport(UObject* InObject);
+
+	FDelegateHandle PostEngineInitHandle;
+	FDelegateHandle AssetPostImportHandle;
+	FDelegateHandle AssetReimportHandle;
 };
@@ -2,6 +2,8 @@
 
 
 #include "AnimGraphNode_Mirror.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Animation/AnimBlueprint.h"
 
 UAnimGraphNode_Mirror::UAnimGraphNode_Mirror(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
@@ -30,3 +32,24 @@ FText UAnimGraphNode_Mirror::GetNodeTitle(ENodeTitleType::Type TitleType) const
     return FText::FromString(Result);
 }
 
+
+
+void UAnimGraphNode_Mirror::ValidateAnimNodeDuringCompilation(USkeleton* ForSkeleton, FCompilerResultsLog& MessageLog)
+{
+    Super::ValidateAnimNodeDuringCompilation(ForSkeleton, MessageLog);
+
+    // Validation leaves the node alone, the table normally comes straight from the DDC
+    FMirrorTable Table;
+    Node.BuildMirrorTable(ForSkeleton, Table);
+    if(Table.UnpairedBones.Num() > 0 || Table.UnpairedCurves.Num() > 0)
+        MessageLog.Note(*FString::Printf(TEXT("@@ left %d bones and %d curves unpaired"), Table.UnpairedBones.Num(), Table.UnpairedCurves.Num()), this);
+}
+
+void UAnimGraphNode_Mirror::BakeDataDuringCompilation(FCompilerResultsLog& MessageLog)
+{
+    Super::BakeDataDuringCompilation(MessageLog);
+
+    // Bake the table so cooked builds never generate it at runtime
+    UAnimBlueprint* AnimBlueprint = GetAnimBlueprint();
+    Node.BuildMirrorTable(AnimBlueprint ? AnimBlueprint->TargetSkeleton : nullptr, true);
+}
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MirrorBenchmarkCommandlet.h"
+#include "MirrorBoneKernels.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMirrorBenchmarkCommandlet, Log, All);
+
+namespace
+{
+    FTransform MakeRandomTransform(FRandomStream& Stream)
+    {
+        FRotator Rot(Stream.FRandRange(-90.f, 90.f), Stream.FRandRange(-180.f, 180.f), Stream.FRandRange(-180.f, 180.f));
+        return FTransform(Rot, Stream.VRand() * Stream.FRandRange(0.f, 20.f));
+    }
+
+    /**
+     * Rules cycle through all axis permutations with the translation signs a mirror plane produces,
+     * rotation signs follow from them the same way the table builder derives them
+     */
+    void MakeSyntheticBatch(int32 NumPairs, FRandomStream& Stream, FMirrorBoneKernelBatch& OutBatch, TArray<FTransform>& OutBones)
+    {
+        static const int32 Perms[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+        static const int32 PermParity[6] = {1, -1, -1, 1, 1, -1};
+        static const int32 Signs[3][3] = {{1, -1, 1}, {-1, 1, 1}, {1, 1, -1}};
+
+        TArray<FMirrorBonePair> TablePairs;
+        for(int32 i = 0; i < NumPairs; i++){
+            FMirrorBonePair& Pair = TablePairs.AddDefaulted_GetRef();
+            Pair.ABoneIndex = i * 2;
+            Pair.BBoneIndex = i * 2 + 1;
+
+            const int32* Perm = Perms[i % 6];
+            const int32* Sign = Signs[(i / 6) % 3];
+            int32 Det = PermParity[i % 6] * Sign[0] * Sign[1] * Sign[2];
+            for(int32 j = 0; j < 3; j++){
+                Pair.FlippingRule.FlipAttrInfo.Add(Perm[j]);
+                Pair.FlippingRule.FlipValInfo.Add(Sign[j]);
+            }
+            for(int32 j = 0; j < 3; j++){
+                Pair.FlippingRule.FlipAttrInfo.Add(Perm[j] + 3);
+                Pair.FlippingRule.FlipValInfo.Add(Sign[j] * Det);
+            }
+            Pair.KernelPattern = FMirrorBoneKernelBatch::GetKernelPattern(Pair.FlippingRule);
+        }
+
+        TablePairs.StableSort(
+            [](const FMirrorBonePair& A, const FMirrorBonePair& B){
+                return A.KernelPattern < B.KernelPattern;
+            }
+        );
+
+        OutBatch.Reset();
+        for(const FMirrorBonePair& Pair : TablePairs)
+            OutBatch.AddPair(Pair, Pair.ABoneIndex, Pair.BBoneIndex, MakeRandomTransform(Stream), MakeRandomTransform(Stream));
+
+        OutBones.SetNum(NumPairs * 2);
+        for(FTransform& Bone : OutBones)
+            Bone = MakeRandomTransform(Stream);
+    }
+
+    template<typename FuncType>
+    double TimeIterations(int32 Iterations, FuncType&& Func)
+    {
+        // One warm up run keeps first touch and kernel table setup out of the numbers
+        Func();
+
+        double StartTime = FPlatformTime::Seconds();
+        for(int32 i = 0; i < Iterations; i++)
+            Func();
+        return (FPlatformTime::Seconds() - StartTime) * 1000000.0 / Iterations;
+    }
+}
+
+UMirrorBenchmarkCommandlet::UMirrorBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UMirrorBenchmarkCommandlet::Main(const FString& Params)
+{
+    int32 MaxPairs = 4096;
+    int32 Iterations = 200;
+    int32 ChunkPairs = 128;
+    float Weight = 1.f;
+    FParse::Value(*Params, TEXT("MaxPairs="), MaxPairs);
+    FParse::Value(*Params, TEXT("Iterations="), Iterations);
+    FParse::Value(*Params, TEXT("ChunkPairs="), ChunkPairs);
+    FParse::Value(*Params, TEXT("Weight="), Weight);
+    Iterations = FMath::Max(Iterations, 1);
+
+    UE_LOG(LogMirrorBenchmarkCommandlet, Display, TEXT("%d task graph workers, %d pairs per chunk, weight %.2f"),
+        FTaskGraphInterface::Get().GetNumWorkerThreads(), ChunkPairs, Weight);
+    UE_LOG(LogMirrorBenchmarkCommandlet, Display, TEXT("%8s %8s %14s %14s %8s"), TEXT("Pairs"), TEXT("Bones"), TEXT("Single (us)"), TEXT("Parallel (us)"), TEXT("Speedup"));
+
+    FRandomStream Stream(0x4D495252);
+    FMirrorBoneKernelBatch Batch;
+    TArray<FTransform> Bones;
+    int32 SuggestedThreshold = INDEX_NONE;
+    for(int32 NumPairs = 32; NumPairs <= MaxPairs; NumPairs *= 2){
+        MakeSyntheticBatch(NumPairs, Stream, Batch, Bones);
+        TArrayView<FTransform> BoneView(Bones);
+
+        double SingleTime = TimeIterations(Iterations, [&](){ Batch.Execute(BoneView, Weight); });
+        double ParallelTime = TimeIterations(Iterations, [&](){ Batch.ExecuteParallel(BoneView, Weight, ChunkPairs); });
+
+        UE_LOG(LogMirrorBenchmarkCommandlet, Display, TEXT("%8d %8d %14.2f %14.2f %7.2fx"),
+            NumPairs, Bones.Num(), SingleTime, ParallelTime, SingleTime / FMath::Max(ParallelTime, 0.001));
+
+        // Smallest size from which going wide keeps paying off by a clear margin
+        bool bParallelWins = ParallelTime * 1.2 < SingleTime;
+        if(!bParallelWins)
+            SuggestedThreshold = INDEX_NONE;
+        else if(SuggestedThreshold == INDEX_NONE)
+            SuggestedThreshold = NumPairs;
+    }
+
+    if(SuggestedThreshold != INDEX_NONE)
+        UE_LOG(LogMirrorBenchmarkCommandlet, Display, TEXT("Suggested ParallelPairThreshold: %d"), SuggestedThreshold);
+    else
+        UE_LOG(LogMirrorBenchmarkCommandlet, Display, TEXT("Parallel mirroring never paid off by 20%%, leave bParallelMirror off on this machine"));
+    return 0;
+}
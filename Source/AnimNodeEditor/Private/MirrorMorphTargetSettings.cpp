@@ -0,0 +1,18 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MirrorMorphTargetSettings.h"
+#include "AnimNode_Mirror.h"
+
+UMirrorMorphTargetSettings::UMirrorMorphTargetSettings()
+    : bDeriveMirroredMorphTargetsOnImport(false)
+    , SymmetryTolerance(0.01f)
+    , MaxReconstructionError(0.01f)
+    , MaxNormalReconstructionError(0.01f)
+{
+    // Same pairing as a freshly placed node
+    FAnimNode_Mirror Defaults;
+    MirPlane = Defaults.MirPlane;
+    SearchReplaceKeyPair = Defaults.SearchReplaceKeyPair;
+    SkipCheckKeyStr = Defaults.SkipCheckKeyStr;
+}
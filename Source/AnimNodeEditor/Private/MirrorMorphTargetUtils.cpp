@@ -0,0 +1,230 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MirrorMorphTargetUtils.h"
+#include "MirrorMorphTargetSettings.h"
+#include "MirrorMorphTargetUserData.h"
+#include "MirrorTable.h"
+#include "Animation/MorphTarget.h"
+#include "Engine/SkeletalMesh.h"
+#include "Rendering/SkeletalMeshRenderData.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMirrorMorphTarget, Log, All);
+
+namespace
+{
+    int64 GetDeltaNum(const TArray<FMorphTargetLODModel>& LODModels)
+    {
+        int64 Num = 0;
+        for(const FMorphTargetLODModel& LODModel : LODModels)
+            Num += LODModel.Vertices.Num();
+        return Num;
+    }
+
+    /** Render sections touched by the deltas of each LOD, sorted */
+    void GetAffectedSections(const TArray<FMorphTargetLODModel>& LODModels, const FSkeletalMeshRenderData* RenderData, TArray<FMirrorMorphTargetSections>& OutLODSections)
+    {
+        OutLODSections.SetNum(LODModels.Num());
+        for(int32 LODIndex = 0; LODIndex < LODModels.Num(); LODIndex++){
+            TArray<int32>& SectionIndices = OutLODSections[LODIndex].SectionIndices;
+            SectionIndices.Reset();
+            if(!RenderData->LODRenderData.IsValidIndex(LODIndex))
+                continue;
+
+            const TArray<FSkelMeshRenderSection>& Sections = RenderData->LODRenderData[LODIndex].RenderSections;
+            for(const FMorphTargetDelta& Delta : LODModels[LODIndex].Vertices){
+                for(int32 SectionIndex = 0; SectionIndex < Sections.Num(); SectionIndex++){
+                    const FSkelMeshRenderSection& Section = Sections[SectionIndex];
+                    if(Delta.SourceIdx >= Section.BaseVertexIndex && Delta.SourceIdx < Section.BaseVertexIndex + Section.NumVertices){
+                        SectionIndices.AddUnique(SectionIndex);
+                        break;
+                    }
+                }
+            }
+            SectionIndices.Sort();
+        }
+    }
+
+    bool HasSameSections(const TArray<FMirrorMorphTargetSections>& LODSections, const TArray<FMorphTargetLODModel>& LODModels)
+    {
+        if(LODSections.Num() != LODModels.Num())
+            return false;
+
+        for(int32 LODIndex = 0; LODIndex < LODModels.Num(); LODIndex++){
+            TArray<int32> SectionIndices = LODModels[LODIndex].SectionIndices;
+            SectionIndices.Sort();
+            if(SectionIndices != LODSections[LODIndex].SectionIndices)
+                return false;
+        }
+        return true;
+    }
+
+    /** Largest position and normal differences between two sets of deltas, missing deltas count as zero */
+    void GetReconstructionError(const TArray<FMorphTargetLODModel>& Rebuilt, const TArray<FMorphTargetLODModel>& Original, float& OutPositionError, float& OutNormalError)
+    {
+        float MaxPositionErrorSq = 0.f;
+        float MaxNormalErrorSq = 0.f;
+        TMap<int32, const FMorphTargetDelta*> OriginalDeltas;
+        for(int32 LODIndex = 0; LODIndex < FMath::Max(Rebuilt.Num(), Original.Num()); LODIndex++){
+            OriginalDeltas.Reset();
+            if(Original.IsValidIndex(LODIndex)){
+                for(const FMorphTargetDelta& Delta : Original[LODIndex].Vertices)
+                    OriginalDeltas.Add(Delta.SourceIdx, &Delta);
+            }
+
+            if(Rebuilt.IsValidIndex(LODIndex)){
+                for(const FMorphTargetDelta& Delta : Rebuilt[LODIndex].Vertices){
+                    const FMorphTargetDelta* OriginalDelta = nullptr;
+                    OriginalDeltas.RemoveAndCopyValue(Delta.SourceIdx, OriginalDelta);
+                    FVector OriginalPosition = OriginalDelta ? OriginalDelta->PositionDelta : FVector::ZeroVector;
+                    FVector OriginalNormal = OriginalDelta ? OriginalDelta->TangentZDelta : FVector::ZeroVector;
+                    MaxPositionErrorSq = FMath::Max(MaxPositionErrorSq, FVector::DistSquared(Delta.PositionDelta, OriginalPosition));
+                    MaxNormalErrorSq = FMath::Max(MaxNormalErrorSq, FVector::DistSquared(Delta.TangentZDelta, OriginalNormal));
+                }
+            }
+
+            for(const TPair<int32, const FMorphTargetDelta*>& KVP : OriginalDeltas){
+                MaxPositionErrorSq = FMath::Max(MaxPositionErrorSq, KVP.Value->PositionDelta.SizeSquared());
+                MaxNormalErrorSq = FMath::Max(MaxNormalErrorSq, KVP.Value->TangentZDelta.SizeSquared());
+            }
+        }
+        OutPositionError = FMath::Sqrt(MaxPositionErrorSq);
+        OutNormalError = FMath::Sqrt(MaxNormalErrorSq);
+    }
+}
+
+void FMirrorMorphTargetUtils::BuildVertexSymmetryMap(const FPositionVertexBuffer& Positions, int32 MirrorAxis, float Tolerance, TArray<int32>& OutMirrorIndices)
+{
+    int32 NumVerts = Positions.GetNumVertices();
+    OutMirrorIndices.Init(INDEX_NONE, NumVerts);
+
+    // Cells as large as the tolerance, so every match lies in one of the 27 cells around the query
+    float CellSize = FMath::Max(Tolerance, KINDA_SMALL_NUMBER);
+    auto GetCell = [CellSize](const FVector& Pos){
+        return FIntVector(FMath::FloorToInt(Pos.X / CellSize), FMath::FloorToInt(Pos.Y / CellSize), FMath::FloorToInt(Pos.Z / CellSize));
+    };
+
+    TMultiMap<FIntVector, int32> Grid;
+    Grid.Reserve(NumVerts);
+    for(int32 i = 0; i < NumVerts; i++)
+        Grid.Add(GetCell(Positions.VertexPosition(i)), i);
+
+    TArray<int32> Candidates;
+    for(int32 i = 0; i < NumVerts; i++){
+        FVector MirrorPos = Positions.VertexPosition(i);
+        MirrorPos[MirrorAxis] *= -1.f;
+        FIntVector Cell = GetCell(MirrorPos);
+
+        float BestDistSq = Tolerance * Tolerance;
+        for(int32 x = -1; x <= 1; x++){
+            for(int32 y = -1; y <= 1; y++){
+                for(int32 z = -1; z <= 1; z++){
+                    Candidates.Reset();
+                    Grid.MultiFind(Cell + FIntVector(x, y, z), Candidates);
+                    for(int32 Candidate : Candidates){
+                        float DistSq = FVector::DistSquared(Positions.VertexPosition(Candidate), MirrorPos);
+                        if(DistSq <= BestDistSq){
+                            BestDistSq = DistSq;
+                            OutMirrorIndices[i] = Candidate;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool FMirrorMorphTargetUtils::DeriveMirroredMorphTargets(USkeletalMesh* Mesh, const UMirrorMorphTargetSettings* Settings, FMirrorMorphTargetReport& OutReport)
+{
+    OutReport = FMirrorMorphTargetReport();
+
+    // Any previous recipe refers to the morph targets and vertices of an older import
+    Mesh->RemoveUserDataOfClass(UMirrorMorphTargetUserData::StaticClass());
+
+    FSkeletalMeshRenderData* RenderData = Mesh->GetResourceForRendering();
+    if(RenderData == nullptr || Mesh->MorphTargets.Num() == 0)
+        return false;
+
+    UMirrorMorphTargetUserData* UserData = NewObject<UMirrorMorphTargetUserData>(Mesh, NAME_None, RF_Transactional);
+    UserData->MirPlane = Settings->MirPlane;
+
+    int32 MirrorAxis = FMirrorTableBuilder::GetMirrorAxis(Settings->MirPlane);
+    for(const FSkeletalMeshLODRenderData& LODData : RenderData->LODRenderData){
+        FMirrorVertexSymmetryMap& SymmetryMap = UserData->LODSymmetryMaps.AddDefaulted_GetRef();
+        BuildVertexSymmetryMap(LODData.StaticVertexBuffers.PositionVertexBuffer, MirrorAxis, Settings->SymmetryTolerance, SymmetryMap.MirrorVertexIndices);
+    }
+
+    // Morph targets are paired exactly like curves
+    TArray<FName> MorphNames;
+    for(UMorphTarget* MorphTarget : Mesh->MorphTargets){
+        if(MorphTarget){
+            MorphNames.Add(MorphTarget->GetFName());
+            OutReport.NumTotalDeltas += GetDeltaNum(MorphTarget->MorphLODModels);
+        }
+    }
+    MorphNames.Sort(FNameLexicalLess());
+
+    FMirrorTable Table;
+    FMirrorTableBuilder Builder(Settings->MirPlane, Settings->SearchReplaceKeyPair, Settings->SkipCheckKeyStr);
+    Builder.Build(TArray<FName>(), TArray<FTransform>(), MorphNames, Table);
+
+    for(const FMirrorCurvePair& Pair : Table.CurvePairs){
+        UMorphTarget* Source = Mesh->FindMorphTarget(Pair.ACurve);
+        UMorphTarget* Mirrored = Mesh->FindMorphTarget(Pair.BCurve);
+        if(Source == nullptr || Mirrored == nullptr)
+            continue;
+
+        OutReport.NumPairs++;
+
+        TArray<FMorphTargetLODModel> Rebuilt;
+        UMirrorMorphTargetUserData::MirrorMorphTargetDeltas(Source, UserData->LODSymmetryMaps, UserData->MirPlane, Rebuilt);
+
+        // Left and right may live in different render sections, e.g. per side materials
+        TArray<FMirrorMorphTargetSections> RebuiltSections;
+        GetAffectedSections(Rebuilt, RenderData, RebuiltSections);
+        if(!HasSameSections(RebuiltSections, Mirrored->MorphLODModels)){
+            UE_LOG(LogMirrorMorphTarget, Display, TEXT("%s: keeping %s, rebuilding it from %s touches other render sections"),
+                *Mesh->GetName(), *Pair.BCurve.ToString(), *Pair.ACurve.ToString());
+            continue;
+        }
+
+        float Error, NormalError;
+        GetReconstructionError(Rebuilt, Mirrored->MorphLODModels, Error, NormalError);
+        if(Error > Settings->MaxReconstructionError || NormalError > Settings->MaxNormalReconstructionError){
+            UE_LOG(LogMirrorMorphTarget, Display, TEXT("%s: keeping %s, rebuilding it from %s is off by %.4f cm, %.4f in normals"),
+                *Mesh->GetName(), *Pair.BCurve.ToString(), *Pair.ACurve.ToString(), Error, NormalError);
+            continue;
+        }
+
+        UE_LOG(LogMirrorMorphTarget, Verbose, TEXT("%s: %s rebuilt from %s, off by %.4f cm, %.4f in normals"),
+            *Mesh->GetName(), *Pair.BCurve.ToString(), *Pair.ACurve.ToString(), Error, NormalError);
+
+        // Use the rebuilt deltas right away, so the editor shows what a load will produce
+        OutReport.NumStripped++;
+        OutReport.NumStrippedDeltas += GetDeltaNum(Mirrored->MorphLODModels);
+        OutReport.MaxError = FMath::Max(OutReport.MaxError, Error);
+        OutReport.MaxNormalError = FMath::Max(OutReport.MaxNormalError, NormalError);
+
+        FMirrorMorphTargetPair& MorphPair = UserData->Pairs.AddDefaulted_GetRef();
+        MorphPair.SourceMorphTarget = Source;
+        MorphPair.MirroredMorphTarget = Mirrored;
+        for(const FMorphTargetLODModel& LODModel : Mirrored->MorphLODModels)
+            MorphPair.LODSectionIndices.AddDefaulted_GetRef().SectionIndices = LODModel.SectionIndices;
+
+        for(int32 LODIndex = 0; LODIndex < Rebuilt.Num(); LODIndex++)
+            Rebuilt[LODIndex].SectionIndices = MorphPair.LODSectionIndices[LODIndex].SectionIndices;
+        Mirrored->MorphLODModels = MoveTemp(Rebuilt);
+    }
+
+    UE_LOG(LogMirrorMorphTarget, Display, TEXT("%s: %d of %d mirrored morph target pairs stored one sided, %lld of %lld deltas (%.1f%%) dropped, max error %.4f cm, %.4f in normals"),
+        *Mesh->GetName(), OutReport.NumStripped, OutReport.NumPairs, OutReport.NumStrippedDeltas, OutReport.NumTotalDeltas,
+        OutReport.NumTotalDeltas > 0 ? 100.0 * OutReport.NumStrippedDeltas / OutReport.NumTotalDeltas : 0.0, OutReport.MaxError, OutReport.MaxNormalError);
+
+    if(UserData->Pairs.Num() == 0)
+        return false;
+
+    Mesh->AddAssetUserData(UserData);
+    Mesh->InitMorphTargetsAndRebuildRenderData();
+    Mesh->MarkPackageDirty();
+    return true;
+}
@@ -0,0 +1,199 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MirrorTableCommandlet.h"
+#include "AnimNode_Mirror.h"
+#include "AnimGraphNode_Mirror.h"
+#include "MirrorTable.h"
+#include "Animation/AnimBlueprint.h"
+#include "Animation/Skeleton.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMirrorTableCommandlet, Log, All);
+
+namespace
+{
+    /** Every input of the table apart from the skeleton */
+    struct FMirrorTableSettings
+    {
+        MirrorPlane MirPlane;
+        FString SearchReplaceKeyPair;
+        FString SkipCheckKeyStr;
+
+        bool operator==(const FMirrorTableSettings& Other) const
+        {
+            return MirPlane == Other.MirPlane && SearchReplaceKeyPair == Other.SearchReplaceKeyPair && SkipCheckKeyStr == Other.SkipCheckKeyStr;
+        }
+
+        FString ToString() const
+        {
+            return FString::Printf(TEXT("%s \"%s\" skip \"%s\""), *StaticEnum<MirrorPlane>()->GetNameStringByValue((int64)MirPlane), *SearchReplaceKeyPair, *SkipCheckKeyStr);
+        }
+    };
+
+    struct FMirrorTableJob
+    {
+        FString SkeletonPath;
+        FMirrorTableSettings Settings;
+        /** Anim blueprints with a mirror node using Settings, empty for the command line fallback */
+        TArray<FString> Users;
+        FReferenceSkeleton RefSkel;
+        TArray<FName> AllCurves;
+        FMirrorTable Table;
+        bool bCacheWasStale = false;
+    };
+
+    bool ParseMirrorPlane(const FString& InStr, MirrorPlane& OutPlane)
+    {
+        if(InStr.StartsWith(TEXT("XZ")))
+            OutPlane = MirrorPlane::XZ_Plane;
+        else if(InStr.StartsWith(TEXT("YZ")))
+            OutPlane = MirrorPlane::YZ_Plane;
+        else if(InStr.StartsWith(TEXT("XY")))
+            OutPlane = MirrorPlane::XY_Plane;
+        else
+            return false;
+        return true;
+    }
+
+    FString JoinNames(const TArray<FName>& Names)
+    {
+        FString Out;
+        for(FName Name : Names){
+            if(!Out.IsEmpty())
+                Out += TEXT(", ");
+            Out += Name.ToString();
+        }
+        return Out;
+    }
+
+    bool IsSameTable(FMirrorTable& A, FMirrorTable& B)
+    {
+        TArray<uint8> AData, BData;
+        FMemoryWriter AAr(AData);
+        FMemoryWriter BAr(BData);
+        A.Serialize(AAr);
+        B.Serialize(BAr);
+        return AData == BData;
+    }
+}
+
+UMirrorTableCommandlet::UMirrorTableCommandlet(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UMirrorTableCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Tokens, Switches;
+    TMap<FString, FString> ParamVals;
+    UCommandlet::ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+    // Same defaults as a freshly placed node
+    FAnimNode_Mirror Defaults;
+    FMirrorTableSettings FallbackSettings{Defaults.MirPlane, Defaults.SearchReplaceKeyPair, Defaults.SkipCheckKeyStr};
+
+    if(const FString* PlaneStr = ParamVals.Find(TEXT("Plane"))){
+        if(!ParseMirrorPlane(*PlaneStr, FallbackSettings.MirPlane)){
+            UE_LOG(LogMirrorTableCommandlet, Error, TEXT("Unknown mirror plane %s, expected XZ, YZ or XY"), **PlaneStr);
+            return 1;
+        }
+    }
+    if(const FString* KeyPairStr = ParamVals.Find(TEXT("SearchReplace")))
+        FallbackSettings.SearchReplaceKeyPair = *KeyPairStr;
+    if(const FString* SkipStr = ParamVals.Find(TEXT("SkipCheck")))
+        FallbackSettings.SkipCheckKeyStr = *SkipStr;
+    bool bFailOnUnpaired = Switches.Contains(TEXT("FailOnUnpaired"));
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.SearchAllAssets(true);
+
+    // Loading has to stay on the game thread, building does not
+    TArray<FMirrorTableJob> Jobs;
+    auto AddJob = [&Jobs](USkeleton* Skel, const FMirrorTableSettings& Settings) -> FMirrorTableJob& {
+        FString SkeletonPath = Skel->GetPathName();
+        FMirrorTableJob* Job = Jobs.FindByPredicate([&](const FMirrorTableJob& Other){ return Other.SkeletonPath == SkeletonPath && Other.Settings == Settings; });
+        if(Job == nullptr){
+            Job = &Jobs.AddDefaulted_GetRef();
+            Job->SkeletonPath = SkeletonPath;
+            Job->Settings = Settings;
+            Job->RefSkel = Skel->GetReferenceSkeleton();
+            FMirrorTableBuilder::GetSkeletonCurveNames(Skel, Job->AllCurves);
+        }
+        return *Job;
+    };
+
+    // One table per distinct skeleton and node settings actually used, these are the keys nodes will request
+    TArray<FAssetData> AnimBlueprintAssets;
+    AssetRegistry.GetAssetsByClass(UAnimBlueprint::StaticClass()->GetFName(), AnimBlueprintAssets, true);
+    TSet<FString> UsedSkeletons;
+    for(const FAssetData& AssetData : AnimBlueprintAssets){
+        UAnimBlueprint* AnimBlueprint = Cast<UAnimBlueprint>(AssetData.GetAsset());
+        if(AnimBlueprint == nullptr || AnimBlueprint->TargetSkeleton == nullptr)
+            continue;
+
+        TArray<UAnimGraphNode_Mirror*> MirrorNodes;
+        FBlueprintEditorUtils::GetAllNodesOfClass(AnimBlueprint, MirrorNodes);
+        for(const UAnimGraphNode_Mirror* MirrorNode : MirrorNodes){
+            FMirrorTableSettings Settings{MirrorNode->Node.MirPlane, MirrorNode->Node.SearchReplaceKeyPair, MirrorNode->Node.SkipCheckKeyStr};
+            FMirrorTableJob& Job = AddJob(AnimBlueprint->TargetSkeleton, Settings);
+            Job.Users.AddUnique(AnimBlueprint->GetPathName());
+            UsedSkeletons.Add(Job.SkeletonPath);
+        }
+    }
+
+    // Skeletons no node mirrors are still validated, with the command line settings
+    TArray<FAssetData> SkeletonAssets;
+    AssetRegistry.GetAssetsByClass(USkeleton::StaticClass()->GetFName(), SkeletonAssets, true);
+    for(const FAssetData& AssetData : SkeletonAssets){
+        if(UsedSkeletons.Contains(AssetData.ObjectPath.ToString()))
+            continue;
+
+        USkeleton* Skel = Cast<USkeleton>(AssetData.GetAsset());
+        if(Skel == nullptr){
+            UE_LOG(LogMirrorTableCommandlet, Warning, TEXT("Failed to load %s"), *AssetData.ObjectPath.ToString());
+            continue;
+        }
+        AddJob(Skel, FallbackSettings);
+    }
+
+    ParallelFor(Jobs.Num(), [&](int32 JobIndex){
+        FMirrorTableJob& Job = Jobs[JobIndex];
+
+        FMirrorTableBuilder Builder(Job.Settings.MirPlane, Job.Settings.SearchReplaceKeyPair, Job.Settings.SkipCheckKeyStr);
+        Builder.Build(Job.RefSkel, Job.AllCurves, Job.Table);
+
+        FMirrorTable CachedTable;
+        if(FMirrorTableBuilder::GetFromDerivedDataCache(Job.Table.DerivedDataKey, CachedTable, Job.SkeletonPath))
+            Job.bCacheWasStale = !IsSameTable(CachedTable, Job.Table);
+
+        FMirrorTableBuilder::PutInDerivedDataCache(Job.Table, Job.SkeletonPath);
+    });
+
+    int32 NumUnpaired = 0;
+    for(const FMirrorTableJob& Job : Jobs){
+        const FMirrorTable& Table = Job.Table;
+        FString Context = FString::Printf(TEXT("%s [%s]"), *Job.SkeletonPath, *Job.Settings.ToString());
+        UE_LOG(LogMirrorTableCommandlet, Display, TEXT("%s: %d bone pairs, %d curve pairs, used by %s"), *Context, Table.BonePairs.Num(), Table.CurvePairs.Num(),
+            Job.Users.Num() > 0 ? *FString::Join(Job.Users, TEXT(", ")) : TEXT("no mirror node"));
+
+        if(Job.bCacheWasStale)
+            UE_LOG(LogMirrorTableCommandlet, Warning, TEXT("%s: cached table did not match the regenerated one"), *Context);
+        if(Table.UnpairedBones.Num() > 0)
+            UE_LOG(LogMirrorTableCommandlet, Warning, TEXT("%s: %d unpaired bones: %s"), *Context, Table.UnpairedBones.Num(), *JoinNames(Table.UnpairedBones));
+        if(Table.UnpairedCurves.Num() > 0)
+            UE_LOG(LogMirrorTableCommandlet, Warning, TEXT("%s: %d unpaired curves: %s"), *Context, Table.UnpairedCurves.Num(), *JoinNames(Table.UnpairedCurves));
+
+        NumUnpaired += Table.UnpairedBones.Num() + Table.UnpairedCurves.Num();
+    }
+
+    UE_LOG(LogMirrorTableCommandlet, Display, TEXT("Regenerated %d mirror tables for %d skeletons, %d unpaired bones and curves"), Jobs.Num(), SkeletonAssets.Num(), NumUnpaired);
+    return (bFailOnUnpaired && NumUnpaired > 0) ? 1 : 0;
+}
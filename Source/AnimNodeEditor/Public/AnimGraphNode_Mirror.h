@@ -22,4 +22,7 @@ class UAnimGraphNode_Mirror : public UAnimGraphNode_Base
 	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
 
 	virtual FString GetNodeCategory() const override;
+
+	virtual void ValidateAnimNodeDuringCompilation(USkeleton* ForSkeleton, FCompilerResultsLog& MessageLog) override;
+	virtual void BakeDataDuringCompilation(FCompilerResultsLog& MessageLog) override;
 };
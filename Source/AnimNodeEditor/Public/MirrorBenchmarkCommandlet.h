@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MirrorBenchmarkCommandlet.generated.h"
+
+/**
+ * Times the mirror kernels on synthetic skeletons of growing pair count, single threaded
+ * and split across task graph workers, prints the scaling as a table and suggests a
+ * ParallelPairThreshold for the machine it ran on:
+ *
+ * UE4Editor-Cmd <Project>.uproject -run=MirrorBenchmark -unattended -nullrhi
+ *     [-MaxPairs=4096] [-Iterations=200] [-ChunkPairs=128] [-Weight=1.0]
+ */
+UCLASS()
+class UMirrorBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "MirrorTable.h"
+#include "MirrorMorphTargetSettings.generated.h"
+
+UCLASS(config=Editor, defaultconfig)
+class UMirrorMorphTargetSettings : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UMirrorMorphTargetSettings();
+
+	/** Store only one side of symmetric morph targets when a skeletal mesh is imported or reimported */
+	UPROPERTY(config, EditAnywhere, Category=MorphTargets)
+	bool bDeriveMirroredMorphTargetsOnImport;
+
+	UPROPERTY(config, EditAnywhere, Category=MorphTargets)
+	MirrorPlane MirPlane;
+
+	UPROPERTY(config, EditAnywhere, Category=MorphTargets)
+	FString SearchReplaceKeyPair;
+
+	UPROPERTY(config, EditAnywhere, Category=MorphTargets)
+	FString SkipCheckKeyStr;
+
+	/** Largest distance between a vertex and the mirrored position of its counterpart, in cm */
+	UPROPERTY(config, EditAnywhere, Category=MorphTargets, meta = (ClampMin = "0.0"))
+	float SymmetryTolerance;
+
+	/** Pairs whose rebuilt deltas differ more than this from the imported ones keep both sides, in cm */
+	UPROPERTY(config, EditAnywhere, Category=MorphTargets, meta = (ClampMin = "0.0"))
+	float MaxReconstructionError;
+
+	/** Same for the normal deltas, which drive shading, as a length in normal space */
+	UPROPERTY(config, EditAnywhere, Category=MorphTargets, meta = (ClampMin = "0.0"))
+	float MaxNormalReconstructionError;
+};
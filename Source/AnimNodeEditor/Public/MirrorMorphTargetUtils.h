@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USkeletalMesh;
+class UMirrorMorphTargetSettings;
+class FPositionVertexBuffer;
+
+struct FMirrorMorphTargetReport
+{
+	int32 NumPairs = 0;
+
+	int32 NumStripped = 0;
+
+	/** Deltas no longer stored on disk */
+	int64 NumStrippedDeltas = 0;
+
+	int64 NumTotalDeltas = 0;
+
+	/** Largest reconstruction error among the stripped pairs, in cm */
+	float MaxError = 0.f;
+
+	/** Largest normal delta reconstruction error among the stripped pairs */
+	float MaxNormalError = 0.f;
+};
+
+class FMirrorMorphTargetUtils
+{
+public:
+	/**
+	 * Finds left/right morph target pairs on Mesh with the mirror node's search/replace rules
+	 * and stores only one side of every pair whose positions and normals can be rebuilt within
+	 * MaxReconstructionError and MaxNormalReconstructionError.
+	 */
+	static bool DeriveMirroredMorphTargets(USkeletalMesh* Mesh, const UMirrorMorphTargetSettings* Settings, FMirrorMorphTargetReport& OutReport);
+
+	/** For every vertex, the vertex closest to its mirrored position within Tolerance */
+	static void BuildVertexSymmetryMap(const FPositionVertexBuffer& Positions, int32 MirrorAxis, float Tolerance, TArray<int32>& OutMirrorIndices);
+};
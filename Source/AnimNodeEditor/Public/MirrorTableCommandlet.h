@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MirrorTableCommandlet.generated.h"
+
+/**
+ * Regenerates the mirror table of every skeleton and mirror node settings pair used by the
+ * anim blueprints of the project, stores it in the DDC and reports the bones and curves that
+ * found no mirror. Skeletons no node uses get the command line settings. Runs headless, e.g. before a cook:
+ *
+ * UE4Editor-Cmd <Project>.uproject -run=MirrorTable -unattended -nullrhi [-Plane=XZ|YZ|XY]
+ *     [-SearchReplace="_l,_r"] [-SkipCheck="twist"] [-FailOnUnpaired]
+ */
+UCLASS()
+class UMirrorTableCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+	virtual int32 Main(const FString& Params) override;
+};